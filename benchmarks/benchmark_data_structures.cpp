@@ -0,0 +1,440 @@
+#include <benchmark/benchmark.h>
+#include "new_sssp.hpp"
+#include "graph_generator.hpp"
+#include "block_data_structure.hpp"
+#include <queue>
+#include <map>
+#include <random>
+#include <limits>
+#include <memory>
+
+using namespace sssp;
+
+/**
+ * Microbenchmarks for the D of BMSSP in isolation.
+ *
+ * Each case replays one operation stream (Insert / BatchPrepend / Pull) on
+ * BlockDataStructure and on two heaps doing the same work: pull removes the
+ * M smallest keys and reports the smallest value left, and inserting a key
+ * that is already present keeps the smaller value. The "ns_per_op" counter
+ * is time per operation, counting every item of a BatchPrepend as one.
+ *
+ * Streams:
+ * - monotone:  N increasing values, then pulls until empty
+ * - random:    N random (key, value) pairs over N / 2 keys, one pull every 2M inserts
+ * - prepend:   N / 4 inserts, then BatchPrepends below every value in D, each
+ *              followed by a pull, with batches halving from 2M items to 1
+ *              (and restarting) until N keys went in
+ * - recorded:  every D operation of a NewSSSP run on a benchmark graph,
+ *              tagged with the D it went to: each BMSSP call has its own D,
+ *              so the replay keeps one adapter per live D
+ */
+
+namespace {
+
+struct DOp {
+    enum Kind { Init, Insert, Prepend, Pull, Destroy } kind;
+    int key;           // Insert / Prepend: key; Init: M
+    double value;      // Insert / Prepend: value; Init: B
+    int instance = 0;  // The D this op went to, numbered in Init order
+};
+
+// A BatchPrepend is a run of Prepend ops closed by a Prepend with key -1.
+// A D lives from its Init to its Destroy (or the end of the stream), and
+// the live ones nest: a D's ops come while it is the innermost.
+struct OpStream {
+    std::vector<DOp> ops;
+    int key_bound = 0;      // All keys are < key_bound
+    size_t op_count = 0;    // Operations as reported by ns_per_op
+    int instances = 1;      // Distinct D instances
+    int max_live = 1;       // Most D instances alive at once
+};
+
+// ----------------------------------------------------------------------------
+// Structures under test, behind one interface
+// ----------------------------------------------------------------------------
+
+class BlockAdapter {
+public:
+    explicit BlockAdapter(int) {}
+    void initialize(int m, double b) { D.initialize(m, b); }
+    void insert(int key, double value) { D.insert(key, value); }
+    void batchPrepend(std::vector<BlockDataStructure::KeyValue>& items) { D.batchPrepend(items); }
+    std::pair<size_t, double> pull() {
+        auto [keys, separator] = D.pull();
+        return {keys.size(), separator};
+    }
+
+private:
+    BlockDataStructure D;
+};
+
+// std::priority_queue with lazy deletion; current value per key in an array
+class PriorityQueueAdapter {
+public:
+    explicit PriorityQueueAdapter(int key_bound)
+        : current(key_bound, std::numeric_limits<double>::infinity()) {}
+
+    void initialize(int m, double b) {
+        while (!pq.empty()) {
+            current[pq.top().second] = std::numeric_limits<double>::infinity();
+            pq.pop();
+        }
+        M = m;
+        B = b;
+    }
+
+    void insert(int key, double value) {
+        if (value < current[key]) {
+            current[key] = value;
+            pq.push({value, key});
+        }
+    }
+
+    void batchPrepend(std::vector<BlockDataStructure::KeyValue>& items) {
+        for (const auto& [key, value] : items) insert(key, value);
+    }
+
+    std::pair<size_t, double> pull() {
+        size_t taken = 0;
+        while (static_cast<int>(taken) < M && !pq.empty()) {
+            auto [value, key] = pq.top();
+            pq.pop();
+            if (current[key] == value) {
+                current[key] = std::numeric_limits<double>::infinity();
+                taken++;
+            }
+        }
+        while (!pq.empty() && current[pq.top().second] != pq.top().first) pq.pop();
+        return {taken, pq.empty() ? B : pq.top().first};
+    }
+
+private:
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    std::vector<double> current;
+    int M = 1;
+    double B = 0;
+};
+
+// Indexed d-ary min-heap with decrease-key; position of every key in an array
+template <int Arity>
+class DaryHeapAdapter {
+public:
+    explicit DaryHeapAdapter(int key_bound) : position(key_bound, -1) {}
+
+    void initialize(int m, double b) {
+        for (const auto& entry : heap) position[entry.second] = -1;
+        heap.clear();
+        M = m;
+        B = b;
+    }
+
+    void insert(int key, double value) {
+        int pos = position[key];
+        if (pos < 0) {
+            heap.push_back({value, key});
+            siftUp(static_cast<int>(heap.size()) - 1);
+        } else if (value < heap[pos].first) {
+            heap[pos].first = value;
+            siftUp(pos);
+        }
+    }
+
+    void batchPrepend(std::vector<BlockDataStructure::KeyValue>& items) {
+        for (const auto& [key, value] : items) insert(key, value);
+    }
+
+    std::pair<size_t, double> pull() {
+        size_t taken = 0;
+        while (static_cast<int>(taken) < M && !heap.empty()) {
+            position[heap[0].second] = -1;
+            heap[0] = heap.back();
+            heap.pop_back();
+            if (!heap.empty()) siftDown(0);
+            taken++;
+        }
+        return {taken, heap.empty() ? B : heap[0].first};
+    }
+
+private:
+    void place(int pos, const std::pair<double, int>& entry) {
+        heap[pos] = entry;
+        position[entry.second] = pos;
+    }
+
+    void siftUp(int pos) {
+        auto entry = heap[pos];
+        while (pos > 0) {
+            int parent = (pos - 1) / Arity;
+            if (heap[parent].first <= entry.first) break;
+            place(pos, heap[parent]);
+            pos = parent;
+        }
+        place(pos, entry);
+    }
+
+    void siftDown(int pos) {
+        auto entry = heap[pos];
+        int size = static_cast<int>(heap.size());
+        for (;;) {
+            int first = pos * Arity + 1;
+            if (first >= size) break;
+            int best = first;
+            int last = std::min(first + Arity, size);
+            for (int c = first + 1; c < last; ++c) {
+                if (heap[c].first < heap[best].first) best = c;
+            }
+            if (heap[best].first >= entry.first) break;
+            place(pos, heap[best]);
+            pos = best;
+        }
+        place(pos, entry);
+    }
+
+    std::vector<std::pair<double, int>> heap;  // (value, key)
+    std::vector<int> position;                 // -1 if absent
+    int M = 1;
+    double B = 0;
+};
+
+// One adapter per D that can be alive at once, reused across replays;
+// an instance gets the innermost free one at its Init
+template <typename Adapter>
+struct AdapterStack {
+    explicit AdapterStack(const OpStream& stream) : slot(stream.instances, -1) {
+        for (int i = 0; i < stream.max_live; ++i) {
+            adapters.push_back(std::make_unique<Adapter>(stream.key_bound));
+        }
+    }
+
+    std::vector<std::unique_ptr<Adapter>> adapters;
+    std::vector<int> slot;  // Adapter of each instance
+    std::vector<BlockDataStructure::KeyValue> batch;
+};
+
+template <typename Adapter>
+size_t replay(const OpStream& stream, AdapterStack<Adapter>& stack) {
+    size_t pulled = 0;
+    int live = 0;
+    auto& batch = stack.batch;
+    for (const auto& op : stream.ops) {
+        if (op.kind == DOp::Init) stack.slot[op.instance] = live++;
+        Adapter& D = *stack.adapters[stack.slot[op.instance]];
+        switch (op.kind) {
+            case DOp::Init:
+                D.initialize(op.key, op.value);
+                break;
+            case DOp::Destroy:
+                live--;
+                break;
+            case DOp::Insert:
+                D.insert(op.key, op.value);
+                break;
+            case DOp::Prepend:
+                if (op.key >= 0) {
+                    batch.emplace_back(op.key, op.value);
+                } else {
+                    D.batchPrepend(batch);
+                    batch.clear();
+                }
+                break;
+            case DOp::Pull: {
+                auto [taken, separator] = D.pull();
+                benchmark::DoNotOptimize(separator);
+                pulled += taken;
+                break;
+            }
+        }
+    }
+    return pulled;
+}
+
+// ----------------------------------------------------------------------------
+// Streams
+// ----------------------------------------------------------------------------
+
+OpStream monotoneStream(int M, int N) {
+    OpStream stream;
+    stream.key_bound = N;
+    stream.ops.push_back({DOp::Init, M, 1e18});
+    for (int i = 0; i < N; ++i) {
+        stream.ops.push_back({DOp::Insert, i, static_cast<double>(i)});
+    }
+    for (int i = 0; i < (N + M - 1) / M; ++i) {
+        stream.ops.push_back({DOp::Pull, 0, 0});
+    }
+    stream.op_count = stream.ops.size() - 1;
+    return stream;
+}
+
+OpStream randomStream(int M, int N) {
+    std::mt19937 rng(61);
+    std::uniform_int_distribution<int> key_dist(0, std::max(0, N / 2 - 1));
+    std::uniform_real_distribution<double> value_dist(0.0, 1000.0);
+
+    OpStream stream;
+    stream.key_bound = N / 2 + 1;
+    stream.ops.push_back({DOp::Init, M, 1e18});
+    for (int i = 1; i <= N; ++i) {
+        stream.ops.push_back({DOp::Insert, key_dist(rng), value_dist(rng)});
+        if (i % (2 * M) == 0) {
+            stream.ops.push_back({DOp::Pull, 0, 0});
+        }
+    }
+    stream.op_count = stream.ops.size() - 1;
+    return stream;
+}
+
+OpStream prependStream(int M, int N) {
+    OpStream stream;
+    stream.key_bound = N;
+    stream.ops.push_back({DOp::Init, M, 1e18});
+    int key = 0;
+    for (; key < N / 4; ++key) {
+        stream.ops.push_back({DOp::Insert, key, static_cast<double>(2 * N + key)});
+    }
+    // Every batch goes below the values already in D, as K does in BMSSP
+    double floor = N;
+    int batches = 0;
+    for (int size = 2 * M; key < N; size = size > 1 ? size / 2 : 2 * M) {
+        int count = std::min(size, N - key);
+        floor -= count;
+        for (int i = 0; i < count; ++i) {
+            stream.ops.push_back({DOp::Prepend, key++, floor + i});
+        }
+        stream.ops.push_back({DOp::Prepend, -1, 0});
+        stream.ops.push_back({DOp::Pull, 0, 0});
+        batches++;
+    }
+    stream.op_count = stream.ops.size() - 1 - batches;
+    return stream;
+}
+
+// BlockDataStructure that appends every operation to `sink`, tagged with
+// the instance (one per BMSSP call)
+class RecordingBlockDataStructure : public BlockDataStructure {
+public:
+    static inline OpStream* sink = nullptr;
+    static inline int live = 0;
+
+    RecordingBlockDataStructure() : instance(sink->instances++) {
+        sink->max_live = std::max(sink->max_live, ++live);
+    }
+
+    ~RecordingBlockDataStructure() {
+        sink->ops.push_back({DOp::Destroy, 0, 0, instance});
+        live--;
+    }
+
+    void initialize(int m, double b, int max_n = 0) {
+        sink->ops.push_back({DOp::Init, std::max(1, m), b, instance});
+        BlockDataStructure::initialize(m, b, max_n);
+    }
+
+    void insert(int key, double value) {
+        sink->ops.push_back({DOp::Insert, key, value, instance});
+        sink->op_count++;
+        BlockDataStructure::insert(key, value);
+    }
+
+    void batchPrepend(std::vector<KeyValue>& items) {
+        for (const auto& [key, value] : items) {
+            sink->ops.push_back({DOp::Prepend, key, value, instance});
+        }
+        sink->ops.push_back({DOp::Prepend, -1, 0, instance});
+        sink->op_count += items.size();
+        BlockDataStructure::batchPrepend(items);
+    }
+
+    std::pair<std::vector<int>, double> pull() {
+        sink->ops.push_back({DOp::Pull, 0, 0, instance});
+        sink->op_count++;
+        return BlockDataStructure::pull();
+    }
+
+private:
+    int instance;
+};
+
+const OpStream& recordedStream(int family) {
+    static std::map<int, OpStream> streams;
+    auto it = streams.find(family);
+    if (it != streams.end()) return it->second;
+
+    SimpleGraph g = family == 0 ? GraphGenerator::scaleFree(10000, 5, 3, 1.0, 100.0, 61)
+                                : GraphGenerator::grid(100, 100, 1.0, 10.0, 61);
+    OpStream& stream = streams[family];
+    stream.key_bound = g.n;
+    stream.instances = 0;
+    stream.max_live = 0;
+    RecordingBlockDataStructure::sink = &stream;
+    BasicNewSSSP<DefaultPolicy, SimpleGraph, RecordingBlockDataStructure> solver(g);
+    solver.solve(0);
+    RecordingBlockDataStructure::sink = nullptr;
+    return stream;
+}
+
+template <typename Adapter>
+void runStream(benchmark::State& state, const OpStream& stream) {
+    AdapterStack<Adapter> stack(stream);
+    size_t pulled = 0;
+    for (auto _ : state) {
+        pulled = replay(stream, stack);
+        benchmark::DoNotOptimize(pulled);
+    }
+    state.counters["ns_per_op"] = benchmark::Counter(
+        static_cast<double>(stream.op_count) * 1e-9,
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["ops"] = static_cast<double>(stream.op_count);
+}
+
+}  // namespace
+
+// ============================================================================
+// Synthetic streams across M and N: Args = {M, N}
+// ============================================================================
+
+template <typename Adapter>
+static void BM_DS_Monotone(benchmark::State& state) {
+    runStream<Adapter>(state, monotoneStream(state.range(0), state.range(1)));
+}
+
+template <typename Adapter>
+static void BM_DS_Random(benchmark::State& state) {
+    runStream<Adapter>(state, randomStream(state.range(0), state.range(1)));
+}
+
+template <typename Adapter>
+static void BM_DS_Prepend(benchmark::State& state) {
+    runStream<Adapter>(state, prependStream(state.range(0), state.range(1)));
+}
+
+static void syntheticArgs(benchmark::internal::Benchmark* b) {
+    b->ArgsProduct({{1, 16, 256}, {1 << 10, 1 << 12}})->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_TEMPLATE(BM_DS_Monotone, BlockAdapter)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Monotone, PriorityQueueAdapter)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Monotone, DaryHeapAdapter<4>)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Random, BlockAdapter)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Random, PriorityQueueAdapter)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Random, DaryHeapAdapter<4>)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Prepend, BlockAdapter)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Prepend, PriorityQueueAdapter)->Apply(syntheticArgs);
+BENCHMARK_TEMPLATE(BM_DS_Prepend, DaryHeapAdapter<4>)->Apply(syntheticArgs);
+
+// ============================================================================
+// Streams recorded from NewSSSP: 0 = scale-free (n = 10^4), 1 = 100x100 grid
+// ============================================================================
+
+template <typename Adapter>
+static void BM_DS_Recorded(benchmark::State& state) {
+    const auto& stream = recordedStream(state.range(0));
+    runStream<Adapter>(state, stream);
+    state.SetLabel(state.range(0) == 0 ? "scale-free" : "grid");
+}
+
+BENCHMARK_TEMPLATE(BM_DS_Recorded, BlockAdapter)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DS_Recorded, PriorityQueueAdapter)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DS_Recorded, DaryHeapAdapter<4>)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
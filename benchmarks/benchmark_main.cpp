@@ -2,7 +2,21 @@
 #include "new_sssp.hpp"
 #include "dijkstra_lemon.hpp"
 #include "graph_generator.hpp"
+#include "filtered_graph.hpp"
+#include "csr_graph.hpp"
+#include "graph_cache.hpp"
+#include "road_network.hpp"
+#include "frontier.hpp"
+#include "pull_data_structures.hpp"
+#include "sharded_block_data_structure.hpp"
+#include "memory_tracker.hpp"
+// Only memory-accounting builds pay for the counting allocator's block headers
+#ifdef SSSP_ENABLE_MEMORY_TRACKING
+#include "counting_allocator.hpp"
+#endif
 #include <memory>
+#include <mutex>
+#include <thread>
 
 using namespace sssp;
 
@@ -10,30 +24,86 @@ using namespace sssp;
 // Benchmark fixtures for different graph types and sizes
 // ============================================================================
 
-// Global graph storage to avoid regenerating graphs for each benchmark iteration
+// Global graph storage to avoid regenerating graphs for each benchmark iteration.
+// Generated graphs are also kept on disk (graph_cache.hpp), keyed by generator,
+// parameters and seed, so later runs map them instead of regenerating.
 namespace {
     std::map<std::string, SimpleGraph> graph_cache;
 
+    GraphCache& diskGraphs() {
+        static GraphCache cache;
+        return cache;
+    }
+
+    std::string diskKey(const std::string& generator, const std::string& params, int seed) {
+        return generator + "_" + params + "_s" + std::to_string(seed) +
+               "_v" + std::to_string(GraphGenerator::version);
+    }
+
+    const MappedGraph& getOrMapGraph(int n, int m, int seed) {
+        std::string key = diskKey("randomSparse",
+                                  "n" + std::to_string(n) + "_m" + std::to_string(m) + "_w1-100", seed);
+        return diskGraphs().get(key, [&] {
+            return GraphGenerator::randomSparse(n, m, 1.0, 100.0, seed);
+        });
+    }
+
+    // Streamed straight into the cache file, never held as adjacency lists
+    const MappedGraph& getOrMapRoadNetwork(int side, int seed) {
+        std::string key = diskKey("roadNetwork", std::to_string(side) + "x" + std::to_string(side), seed);
+        return diskGraphs().getWritten(key, [&](const std::string& file) {
+            RoadNetworkOptions options;
+            options.rows = options.cols = side;
+            options.seed = seed;
+            RoadNetwork(options).writeGraphFile(file, key);
+        });
+    }
+
     SimpleGraph& getOrCreateGraph(const std::string& key, int n, int m, int seed) {
         if (graph_cache.find(key) == graph_cache.end()) {
-            graph_cache[key] = GraphGenerator::randomSparse(n, m, 1.0, 100.0, seed);
+            graph_cache[key] = getOrMapGraph(n, m, seed).toSimpleGraph();
         }
         return graph_cache[key];
     }
 
     SimpleGraph& getOrCreateGrid(const std::string& key, int rows, int cols, int seed) {
         if (graph_cache.find(key) == graph_cache.end()) {
-            graph_cache[key] = GraphGenerator::grid(rows, cols, 1.0, 10.0, seed);
+            std::string disk_key = diskKey(
+                "grid", std::to_string(rows) + "x" + std::to_string(cols) + "_w1-10", seed);
+            graph_cache[key] = diskGraphs().get(disk_key, [&] {
+                return GraphGenerator::grid(rows, cols, 1.0, 10.0, seed);
+            }).toSimpleGraph();
         }
         return graph_cache[key];
     }
 
     SimpleGraph& getOrCreateScaleFree(const std::string& key, int n, int seed) {
         if (graph_cache.find(key) == graph_cache.end()) {
-            graph_cache[key] = GraphGenerator::scaleFree(n, 5, 3, 1.0, 100.0, seed);
+            std::string disk_key = diskKey("scaleFree", "n" + std::to_string(n) + "_5_3_w1-100", seed);
+            graph_cache[key] = diskGraphs().get(disk_key, [&] {
+                return GraphGenerator::scaleFree(n, 5, 3, 1.0, 100.0, seed);
+            }).toSimpleGraph();
         }
         return graph_cache[key];
     }
+
+    // Allocation counters from one extra, untimed call of `run`:
+    // bytes and allocations per run, peak live bytes, and the D share
+    template <typename F>
+    void addMemoryCounters(benchmark::State& state, F&& run) {
+        if (!MemoryTracker::installed()) return;
+        MemoryTracker::enable(true);
+        MemoryRun measured;
+        run();
+        MemoryUsage usage = measured.finish();
+        MemoryTracker::enable(false);
+
+        state.counters["alloc_bytes"] = static_cast<double>(usage.total.allocated_bytes);
+        state.counters["allocs"] = static_cast<double>(usage.total.allocations);
+        state.counters["peak_bytes"] = static_cast<double>(usage.total.peak_live_bytes);
+        state.counters["D_allocs"] =
+            static_cast<double>(usage[MemoryCategory::DataStructure].allocations);
+    }
 }
 
 // ============================================================================
@@ -54,6 +124,7 @@ static void BM_Dijkstra_Sparse(benchmark::State& state) {
     state.SetComplexityN(n);
     state.counters["nodes"] = n;
     state.counters["edges"] = g.m;
+    addMemoryCounters(state, [&] { auto result = SimpleDijkstra::solve(g, 0); });
 }
 
 static void BM_NewSSSP_Sparse(benchmark::State& state) {
@@ -71,6 +142,10 @@ static void BM_NewSSSP_Sparse(benchmark::State& state) {
     state.SetComplexityN(n);
     state.counters["nodes"] = n;
     state.counters["edges"] = g.m;
+    addMemoryCounters(state, [&] {
+        NewSSSP solver(g);
+        auto result = solver.solve(0);
+    });
 }
 
 static void BM_LemonDijkstra_Sparse(benchmark::State& state) {
@@ -87,6 +162,7 @@ static void BM_LemonDijkstra_Sparse(benchmark::State& state) {
     state.SetComplexityN(n);
     state.counters["nodes"] = n;
     state.counters["edges"] = g.m;
+    addMemoryCounters(state, [&] { auto result = DijkstraLemon::solve(g, 0); });
 }
 
 // Register sparse benchmarks
@@ -282,11 +358,12 @@ BENCHMARK(BM_NewSSSP_ScaleFree)
 // Huge Sparse Graphs - Testing scalability limits
 // ============================================================================
 
+// Both run on the mapped file directly: no copy into adjacency lists, so a
+// cached graph costs nothing to load and the solvers see the CSR layout
 static void BM_Dijkstra_Huge(benchmark::State& state) {
     int n = state.range(0);
     int m = n * 3;
-    std::string key = "huge_" + std::to_string(n);
-    auto& g = getOrCreateGraph(key, n, m, 47);
+    const MappedGraph& g = getOrMapGraph(n, m, 47);
 
     for (auto _ : state) {
         auto result = SimpleDijkstra::solve(g, 0);
@@ -300,11 +377,10 @@ static void BM_Dijkstra_Huge(benchmark::State& state) {
 static void BM_NewSSSP_Huge(benchmark::State& state) {
     int n = state.range(0);
     int m = n * 3;
-    std::string key = "huge_" + std::to_string(n);
-    auto& g = getOrCreateGraph(key, n, m, 47);
+    const MappedGraph& g = getOrMapGraph(n, m, 47);
 
     for (auto _ : state) {
-        NewSSSP solver(g);
+        BasicNewSSSP<DefaultPolicy, MappedGraph> solver(g);
         auto result = solver.solve(0);
         benchmark::DoNotOptimize(result);
     }
@@ -325,6 +401,50 @@ BENCHMARK(BM_NewSSSP_Huge)
     ->Arg(5000000)
     ->Unit(benchmark::kMillisecond);
 
+// ============================================================================
+// Road Networks - geometric, low degree, large diameter (road_network.hpp)
+// ============================================================================
+
+// Square networks of side^2 vertices, from a corner, on the mapped file
+static void BM_Dijkstra_Road(benchmark::State& state) {
+    int side = state.range(0);
+    const MappedGraph& g = getOrMapRoadNetwork(side, 53);
+
+    for (auto _ : state) {
+        auto result = SimpleDijkstra::solve(g, 0);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["nodes"] = g.n;
+    state.counters["edges"] = g.m;
+}
+
+static void BM_NewSSSP_Road(benchmark::State& state) {
+    int side = state.range(0);
+    const MappedGraph& g = getOrMapRoadNetwork(side, 53);
+
+    for (auto _ : state) {
+        BasicNewSSSP<DefaultPolicy, MappedGraph> solver(g);
+        auto result = solver.solve(0);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["nodes"] = g.n;
+    state.counters["edges"] = g.m;
+}
+
+BENCHMARK(BM_Dijkstra_Road)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_NewSSSP_Road)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+
 // ============================================================================
 // Comparison at specific sizes for direct comparison
 // ============================================================================
@@ -410,5 +530,509 @@ BENCHMARK(BM_Comparison_1M)
     ->Arg(1)
     ->Unit(benchmark::kMillisecond);
 
+// ============================================================================
+// Solver policies - distance-only, uninstrumented vs fully tracked
+// ============================================================================
+
+template <typename Policy>
+static void BM_NewSSSP_Policy(benchmark::State& state) {
+    int n = state.range(0);
+    int m = n * 2;
+    std::string key = "sparse_" + std::to_string(n) + "_" + std::to_string(m);
+    auto& g = getOrCreateGraph(key, n, m, 42);
+
+    BasicNewSSSP<Policy> solver(g);
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+
+    for (auto _ : state) {
+        solver.solve(0, distances, predecessors);
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.counters["nodes"] = n;
+    state.counters["edges"] = g.m;
+}
+
+template <typename Policy>
+static void BM_Dijkstra_Policy(benchmark::State& state) {
+    int n = state.range(0);
+    int m = n * 2;
+    std::string key = "sparse_" + std::to_string(n) + "_" + std::to_string(m);
+    auto& g = getOrCreateGraph(key, n, m, 42);
+
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+
+    for (auto _ : state) {
+        SimpleDijkstra::solve<Policy>(g, 0, distances, predecessors);
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.counters["nodes"] = n;
+    state.counters["edges"] = g.m;
+}
+
+BENCHMARK_TEMPLATE(BM_NewSSSP_Policy, DefaultPolicy)
+    ->RangeMultiplier(4)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_NewSSSP_Policy, DistanceOnlyPolicy)
+    ->RangeMultiplier(4)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Dijkstra_Policy, DefaultPolicy)
+    ->RangeMultiplier(4)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Dijkstra_Policy, DistanceOnlyPolicy)
+    ->RangeMultiplier(4)
+    ->Range(10000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Visitors - a visitor with every hook returning Continue should cost the
+// same as the plain solve
+// ============================================================================
+
+namespace {
+    struct NoOpVisitor {
+        VisitAction discover(int, double) { return VisitAction::Continue; }
+        VisitAction relax(int, int, double, double) { return VisitAction::Continue; }
+        VisitAction settle(int, double) { return VisitAction::Continue; }
+        void finish() {}
+    };
+}
+
+static void BM_Dijkstra_Visitor(benchmark::State& state) {
+    int n = state.range(0);
+    int m = n * 2;
+    std::string key = "sparse_" + std::to_string(n) + "_" + std::to_string(m);
+    auto& g = getOrCreateGraph(key, n, m, 42);
+
+    bool use_visitor = state.range(1) == 1;
+    NoOpVisitor visitor;
+
+    for (auto _ : state) {
+        if (use_visitor) {
+            auto result = SimpleDijkstra::solve(g, 0, visitor);
+            benchmark::DoNotOptimize(result);
+        } else {
+            auto result = SimpleDijkstra::solve(g, 0);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetLabel(use_visitor ? "NoOpVisitor" : "plain");
+}
+
+static void BM_NewSSSP_Visitor(benchmark::State& state) {
+    int n = state.range(0);
+    int m = n * 2;
+    std::string key = "sparse_" + std::to_string(n) + "_" + std::to_string(m);
+    auto& g = getOrCreateGraph(key, n, m, 42);
+
+    bool use_visitor = state.range(1) == 1;
+    NoOpVisitor visitor;
+
+    for (auto _ : state) {
+        NewSSSP solver(g);
+        if (use_visitor) {
+            auto result = solver.solve(0, visitor);
+            benchmark::DoNotOptimize(result);
+        } else {
+            auto result = solver.solve(0);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    state.SetLabel(use_visitor ? "NoOpVisitor" : "plain");
+}
+
+BENCHMARK(BM_Dijkstra_Visitor)
+    ->ArgsProduct({{100000, 1000000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_NewSSSP_Visitor)
+    ->ArgsProduct({{100000, 1000000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Filtered graph views - overhead of the vertex/edge masks
+// Mode 0: SimpleGraph, 1: FilteredGraph with nothing closed,
+// 2: FilteredGraph with 1% of edges and 0.1% of vertices closed
+// ============================================================================
+
+namespace {
+    FilteredGraph makeFilteredView(const SimpleGraph& g, int mode) {
+        FilteredGraph view(g);
+        if (mode == 2) {
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<int> node_dist(1, g.n - 1);
+            std::uniform_int_distribution<size_t> edge_dist(0, g.m - 1);
+            for (int i = 0; i < g.m / 100; ++i) view.closeEdge(edge_dist(rng));
+            for (int i = 0; i < g.n / 1000; ++i) view.closeVertex(node_dist(rng));
+        }
+        return view;
+    }
+
+    const char* filterModeLabel(int mode) {
+        return mode == 0 ? "SimpleGraph" : (mode == 1 ? "FilteredGraph" : "FilteredGraph 1% closed");
+    }
+}
+
+static void BM_Dijkstra_Filtered(benchmark::State& state) {
+    int size = state.range(0);
+    int mode = state.range(1);
+    std::string key = "grid_" + std::to_string(size);
+    auto& g = getOrCreateGrid(key, size, size, 45);
+    FilteredGraph view = makeFilteredView(g, mode);
+
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+
+    for (auto _ : state) {
+        if (mode == 0) {
+            SimpleDijkstra::solve(g, 0, distances, predecessors);
+        } else {
+            SimpleDijkstra::solve(view, 0, distances, predecessors);
+        }
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.SetLabel(filterModeLabel(mode));
+    state.counters["edges"] = g.m;
+}
+
+static void BM_NewSSSP_Filtered(benchmark::State& state) {
+    int size = state.range(0);
+    int mode = state.range(1);
+    std::string key = "grid_" + std::to_string(size);
+    auto& g = getOrCreateGrid(key, size, size, 45);
+    FilteredGraph view = makeFilteredView(g, mode);
+
+    NewSSSP plain_solver(g);
+    BasicNewSSSP<DefaultPolicy, FilteredGraph> view_solver(view);
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+
+    for (auto _ : state) {
+        if (mode == 0) {
+            plain_solver.solve(0, distances, predecessors);
+        } else {
+            view_solver.solve(0, distances, predecessors);
+        }
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.SetLabel(filterModeLabel(mode));
+    state.counters["edges"] = g.m;
+}
+
+BENCHMARK(BM_Dijkstra_Filtered)
+    ->ArgsProduct({{300, 1000}, {0, 1, 2}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_NewSSSP_Filtered)
+    ->ArgsProduct({{100, 300}, {0, 1, 2}})
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Weight-sorted CSR - early cut-off in the bounded relax loops
+// Heavy-tailed (Pareto) weights on a grid, where most edges at deep levels
+// exceed the remaining slack.
+// Mode 0: SimpleGraph, 1: CSRGraph, 2: CSRGraph sorted by weight
+// ============================================================================
+
+namespace {
+    SimpleGraph& getOrCreateHeavyTailedGrid(const std::string& key, int size, int seed) {
+        if (graph_cache.find(key) == graph_cache.end()) {
+            SimpleGraph g = GraphGenerator::grid(size, size, 1.0, 10.0, seed);
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            for (auto& edges : g.adj) {
+                for (auto& edge : edges) {
+                    // Pareto with alpha = 1.2, scale 1
+                    edge.second = std::pow(1.0 - unit(rng), -1.0 / 1.2);
+                }
+            }
+            graph_cache[key] = std::move(g);
+        }
+        return graph_cache[key];
+    }
+}
+
+static void BM_NewSSSP_WeightSorted(benchmark::State& state) {
+    int size = state.range(0);
+    int mode = state.range(1);
+    std::string key = "pareto_grid_" + std::to_string(size);
+    auto& g = getOrCreateHeavyTailedGrid(key, size, 48);
+    CSRGraph csr(g, mode == 2);
+
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    size_t relaxations = 0;
+
+    for (auto _ : state) {
+        if (mode == 0) {
+            NewSSSP solver(g);
+            solver.solve(0, distances, predecessors);
+            relaxations = solver.getRelaxationCount();
+        } else {
+            BasicNewSSSP<DefaultPolicy, CSRGraph> solver(csr);
+            solver.solve(0, distances, predecessors);
+            relaxations = solver.getRelaxationCount();
+        }
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.SetLabel(mode == 0 ? "SimpleGraph" : (mode == 1 ? "CSR" : "CSR weight-sorted"));
+    state.counters["edges"] = g.m;
+    state.counters["relaxations"] = relaxations;
+}
+
+BENCHMARK(BM_NewSSSP_WeightSorted)
+    ->ArgsProduct({{100, 300}, {0, 1, 2}})
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// findPivots frontier - one Bellman-Ford round: fill with s vertices, then
+// visit them in ascending order. n = 1M, s = n / range(0)
+// Mode 0: std::set, 1: Frontier (sparse list or dense bitmap by size)
+// ============================================================================
+
+static void BM_FrontierRound(benchmark::State& state) {
+    const int n = 1 << 20;
+    int s = n / static_cast<int>(state.range(0));
+    int mode = state.range(1);
+
+    std::mt19937 rng(56);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<int> vertices(s);
+    for (int& v : vertices) v = pick(rng);
+
+    Frontier frontier(n);
+    long long sum = 0;
+
+    for (auto _ : state) {
+        if (mode == 0) {
+            std::set<int> round;
+            for (int v : vertices) round.insert(v);
+            for (int v : round) sum += v;
+        } else {
+            frontier.clear();
+            for (int v : vertices) frontier.insert(v);
+            frontier.forEach([&](int v) { sum += v; return true; });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetLabel(mode == 0 ? "std::set" : (frontier.isDense() ? "dense" : "sparse"));
+    state.SetItemsProcessed(state.iterations() * s);
+}
+
+BENCHMARK(BM_FrontierRound)
+    ->ArgsProduct({{16384, 2048, 256, 8}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// D implementation x graph family, n = 10^4
+// LazyBlockDataStructure also reports its stale-entry ratio; RuntimeBlockSizeD
+// is the same D with fixed block sizes off
+// Family 0: random sparse (m = 5n), 1: grid, 2: scale-free
+// ============================================================================
+
+namespace {
+    SimpleGraph& getFamilyGraph(int family) {
+        switch (family) {
+            case 0:  return getOrCreateGraph("family_random_10000", 10000, 50000, 57);
+            case 1:  return getOrCreateGrid("family_grid_100", 100, 100, 57);
+            default: return getOrCreateScaleFree("family_scalefree_10000", 10000, 57);
+        }
+    }
+
+    const char* familyName(int family) {
+        return family == 0 ? "random" : (family == 1 ? "grid" : "scale-free");
+    }
+}
+
+namespace {
+    // LazyBlockDataStructure without the Fixed alias, so every BMSSP level
+    // runs with the runtime M: the solve-level baseline for the dispatch
+    class RuntimeBlockSizeD {
+    public:
+        using KeyValue = LazyBlockDataStructure::KeyValue;
+        using Stats = LazyBlockDataStructure::Stats;
+
+        void initialize(int m, double b, int max_n = 0) { D.initialize(m, b, max_n); }
+        bool empty() const { return D.empty(); }
+        size_t size() const { return D.size(); }
+        void insert(int key, double value) { D.insert(key, value); }
+        void batchPrepend(std::vector<KeyValue>& items) { D.batchPrepend(items); }
+        std::pair<std::vector<int>, double> pull() { return D.pull(); }
+        const Stats& stats() const { return D.stats(); }
+
+    private:
+        LazyBlockDataStructure D;
+    };
+}
+
+template <typename DataStructure>
+static void BM_NewSSSP_DataStructure(benchmark::State& state) {
+    int family = state.range(0);
+    auto& g = getFamilyGraph(family);
+
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    BasicNewSSSP<DefaultPolicy, SimpleGraph, DataStructure> solver(g);
+
+    for (auto _ : state) {
+        solver.solve(0, distances, predecessors);
+        benchmark::DoNotOptimize(distances.data());
+    }
+
+    state.SetLabel(familyName(family));
+    state.counters["relaxations"] = solver.getRelaxationCount();
+    addMemoryCounters(state, [&] { solver.solve(0, distances, predecessors); });
+    if constexpr (std::is_same_v<typename detail::data_structure_stats<DataStructure>::type,
+                                 LazyBlockStats>) {
+        const auto& stats = solver.getDataStructureStats();
+        state.counters["stale_ratio"] = stats.staleRatio();
+        state.counters["compactions"] = stats.compactions;
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_NewSSSP_DataStructure, BlockDataStructure)
+    ->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NewSSSP_DataStructure, LazyBlockDataStructure)
+    ->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NewSSSP_DataStructure, RuntimeBlockSizeD)
+    ->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NewSSSP_DataStructure, HeapDataStructure)
+    ->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NewSSSP_DataStructure, RadixDataStructure)
+    ->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Compile-time block size, on the small D instances of low BMSSP levels:
+// 1024 rounds of 8 * M random inserts followed by pulls until empty.
+// Mode 0: LazyBlockDataStructure (runtime M), 1: FixedBlockDataStructure<M>
+// ============================================================================
+
+template <int M>
+static void BM_FixedBlockSize(benchmark::State& state) {
+    int mode = state.range(0);
+    const int rounds = 1024;
+    const int per_round = 8 * M;
+
+    std::mt19937 rng(60);
+    std::uniform_real_distribution<double> value_dist(0.0, 1000.0);
+    std::vector<double> values(rounds * per_round);
+    for (double& v : values) v = value_dist(rng);
+
+    auto run = [&](auto& D) {
+        size_t pulled = 0;
+        for (int r = 0; r < rounds; ++r) {
+            D.initialize(M, 1000.0, per_round);
+            for (int i = 0; i < per_round; ++i) {
+                D.insert(i, values[r * per_round + i]);
+            }
+            while (!D.empty()) {
+                pulled += D.pull().first.size();
+            }
+        }
+        return pulled;
+    };
+
+    LazyBlockDataStructure runtime_D;
+    FixedBlockDataStructure<M> fixed_D;
+    for (auto _ : state) {
+        size_t pulled = mode == 0 ? run(runtime_D) : run(fixed_D);
+        benchmark::DoNotOptimize(pulled);
+    }
+
+    state.SetLabel(mode == 0 ? "runtime M" : "fixed M");
+    state.SetItemsProcessed(state.iterations() * rounds * per_round);
+}
+
+BENCHMARK_TEMPLATE(BM_FixedBlockSize, 4)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FixedBlockSize, 16)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FixedBlockSize, 64)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Parallel inserts into D: the same 2^18 (key, value) pairs, split round-robin
+// over range(0) threads, then one pull (which merges the shards). Every case
+// builds, fills and pulls exactly one D per iteration. Wall-clock time.
+// Mode 0: serial LazyBlockDataStructure (the baseline, one thread, no lock)
+//      1: one LazyBlockDataStructure behind a mutex, 2: ShardedBlockDataStructure
+// ============================================================================
+
+static void BM_ConcurrentInsert(benchmark::State& state) {
+    int num_threads = state.range(0);
+    int mode = state.range(1);
+    const int num_items = 1 << 18;
+    const int M = 1024;
+
+    std::mt19937 rng(59);
+    std::uniform_int_distribution<int> key_dist(0, num_items / 2);
+    std::uniform_real_distribution<double> value_dist(0.0, 1000.0);
+    std::vector<std::pair<int, double>> items(num_items);
+    for (auto& item : items) item = {key_dist(rng), value_dist(rng)};
+
+    // Thread t inserts items t, t + num_threads, ...
+    auto insertInParallel = [&](auto&& insert) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = t; i < num_items; i += num_threads) {
+                    insert(t, items[i].first, items[i].second);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    };
+
+    size_t pulled = 0;
+    for (auto _ : state) {
+        std::pair<std::vector<int>, double> result;
+        if (mode == 0) {
+            LazyBlockDataStructure D;
+            D.initialize(M, 1000.0, num_items);
+            for (const auto& [key, value] : items) D.insert(key, value);
+            result = D.pull();
+        } else if (mode == 1) {
+            LazyBlockDataStructure D;
+            std::mutex D_mutex;
+            D.initialize(M, 1000.0, num_items);
+            insertInParallel([&](int, int key, double value) {
+                std::lock_guard<std::mutex> lock(D_mutex);
+                D.insert(key, value);
+            });
+            result = D.pull();
+        } else {
+            ShardedBlockDataStructure<> D(num_threads);
+            D.initialize(M, 1000.0, num_items);
+            insertInParallel([&](int t, int key, double value) { D.insert(t, key, value); });
+            result = D.pull();
+        }
+        pulled = result.first.size();
+        benchmark::DoNotOptimize(pulled);
+    }
+
+    const char* labels[] = {"serial", "mutex", "sharded"};
+    state.SetLabel(labels[mode]);
+    state.counters["pulled"] = static_cast<double>(pulled);
+    state.SetItemsProcessed(state.iterations() * num_items);
+}
+
+BENCHMARK(BM_ConcurrentInsert)
+    ->Args({1, 0})
+    ->ArgsProduct({{1, 2, 4, 8}, {1, 2}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
 // Main function
 BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include "operation_counts.hpp"
+#include "graph_generator.hpp"
+#include <map>
+
+using namespace sssp;
+
+/**
+ * Operation counts in the comparison-addition model over growing n.
+ *
+ * Each case runs one solver once with counted distances (operation_counts.hpp)
+ * on a random graph with m = 4n and reports its additions and comparisons,
+ * plus the total divided by each bound:
+ *
+ * - per_m_log23n:  ops / (m log^{2/3} n), the paper's bound for NewSSSP
+ * - per_m_nlogn:   ops / (m + n log n), the sorting barrier (Dijkstra)
+ *
+ * A ratio that stays flat as n grows means the counts follow that bound.
+ * The counts do not depend on the machine; time is reported but is not the
+ * measurement (counted NewSSSP takes tens of seconds at n = 2^16, which is
+ * why the range stops there). To plot, export the counters:
+ *
+ *     ./sssp_benchmarks --benchmark_filter=OperationCount --benchmark_format=csv
+ */
+
+namespace {
+
+const SimpleGraph& operationCountGraph(int n) {
+    static std::map<int, SimpleGraph> graphs;
+    auto it = graphs.find(n);
+    if (it == graphs.end()) {
+        it = graphs.emplace(n, GraphGenerator::randomSparse(n, 4 * n, 1.0, 100.0, 42)).first;
+    }
+    return it->second;
+}
+
+template <typename Count>
+void reportOperationCounts(benchmark::State& state, Count&& count) {
+    const SimpleGraph& g = operationCountGraph(static_cast<int>(state.range(0)));
+
+    OperationCounts counts;
+    for (auto _ : state) {
+        counts = count(g);
+    }
+
+    double ops = static_cast<double>(counts.total());
+    state.counters["nodes"] = g.n;
+    state.counters["edges"] = g.m;
+    state.counters["additions"] = static_cast<double>(counts.additions);
+    state.counters["comparisons"] = static_cast<double>(counts.comparisons);
+    state.counters["ops"] = ops;
+    state.counters["per_m_log23n"] = ops / newSSSPBound(g.n, g.m);
+    state.counters["per_m_nlogn"] = ops / sortingBarrierBound(g.n, g.m);
+}
+
+}  // namespace
+
+static void BM_OperationCount_Dijkstra(benchmark::State& state) {
+    reportOperationCounts(state, [](const SimpleGraph& g) {
+        return countSimpleDijkstraOperations(g, 0);
+    });
+}
+
+static void BM_OperationCount_Lemon(benchmark::State& state) {
+    reportOperationCounts(state, [](const SimpleGraph& g) {
+        return countLemonOperations(g, 0);
+    });
+}
+
+static void BM_OperationCount_NewSSSP(benchmark::State& state) {
+    reportOperationCounts(state, [](const SimpleGraph& g) {
+        return countNewSSSPOperations(g, 0);
+    });
+}
+
+BENCHMARK(BM_OperationCount_Dijkstra)
+    ->RangeMultiplier(2)->Range(1 << 10, 1 << 16)
+    ->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_OperationCount_Lemon)
+    ->RangeMultiplier(2)->Range(1 << 10, 1 << 16)
+    ->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_OperationCount_NewSSSP)
+    ->RangeMultiplier(2)->Range(1 << 10, 1 << 16)
+    ->Iterations(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace sssp {
+
+/**
+ * Controls for the machine state around timed runs: CPU pinning and a
+ * last-level cache flush for cold-cache measurements.
+ *
+ *     std::string error;
+ *     if (!pinToCpu(2, error)) std::cerr << error << "\n";
+ *
+ *     CacheFlusher flusher;   // 2x the LLC
+ *     flusher.flush();        // before each cold run, outside the timer
+ */
+
+// Pins the calling thread to `cpu`. On failure, returns false and sets `error`.
+inline bool pinToCpu(int cpu, std::string& error) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        error = "CPU " + std::to_string(cpu) + " is out of range";
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        error = "sched_setaffinity(" + std::to_string(cpu) + "): " + std::strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    (void)cpu;
+    error = "CPU pinning is only supported on Linux";
+    return false;
+#endif
+}
+
+// CPU the calling thread runs on now, or -1 if unknown
+inline int currentCpu() {
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+// Size of the largest cache level in bytes, or 0 if it cannot be determined
+inline size_t lastLevelCacheBytes() {
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+    for (int name : {_SC_LEVEL4_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+        long size = sysconf(name);
+        if (size > 0) return static_cast<size_t>(size);
+    }
+#endif
+#ifdef __linux__
+    // sysconf may report 0 (e.g. non-glibc); the sysfs cache description is the fallback
+    size_t largest = 0;
+    for (int index = 0; index < 8; ++index) {
+        std::ifstream file("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+        std::string text;
+        if (!(file >> text) || text.empty()) continue;
+        size_t size = std::stoull(text);
+        char unit = text.back();
+        if (unit == 'K') size <<= 10;
+        if (unit == 'M') size <<= 20;
+        if (size > largest) largest = size;
+    }
+    return largest;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Evicts the caches by writing and then reading a buffer of twice the
+ * last-level cache (64 MiB if the size is unknown). The buffer is allocated
+ * once; flush() costs two passes over it.
+ */
+class CacheFlusher {
+public:
+    explicit CacheFlusher(size_t bytes = 0) {
+        if (bytes == 0) {
+            size_t llc = lastLevelCacheBytes();
+            bytes = llc > 0 ? 2 * llc : size_t{64} << 20;
+        }
+        buffer.resize(bytes / sizeof(uint64_t) + 1);
+    }
+
+    void flush() {
+        ++round;
+        for (size_t i = 0; i < buffer.size(); i += line_words) buffer[i] = round + i;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < buffer.size(); i += line_words) sum += buffer[i];
+        sink = sum;
+    }
+
+    size_t bytes() const { return buffer.size() * sizeof(uint64_t); }
+
+private:
+    static constexpr size_t line_words = 64 / sizeof(uint64_t);
+
+    std::vector<uint64_t> buffer;
+    uint64_t round = 0;
+    volatile uint64_t sink = 0;
+};
+
+}  // namespace sssp
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "benchmark_stats.hpp"
+#include "json_value.hpp"
+#include "json_writer.hpp"
+#include "memory_tracker.hpp"
+#include "perf_counters.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Machine-readable results of one sssp_benchmark invocation, and the
+ * baseline comparison built on them.
+ *
+ * JSON holds everything (graph fingerprint, per-run times, stats, per-run
+ * hardware counters, memory); CSV has one row per (algorithm, run). A JSON
+ * report doubles as a baseline: compareToBaseline() matches algorithms by
+ * name and flags a regression when the whole confidence interval of
+ * current / baseline median time lies above 1 + threshold.
+ */
+struct AlgorithmRuns {
+    std::string name;
+    std::vector<double> times_ms;                // One per timed run (all sources), in run order
+    std::vector<PerfCounters::Sample> counters;  // One per run, when counters were read
+    std::vector<double> source_times_ms;         // Multi-source: median per source, as sources
+    std::vector<std::pair<std::string, double>> phases_ms;  // Median per phase of a timed solve
+    MemoryUsage memory;
+    bool has_memory = false;
+};
+
+struct BenchmarkReport {
+    std::string graph_path;
+    int n = 0;
+    int m = 0;
+    bool directed = true;
+    uint64_t fingerprint = 0;
+    int source = 0;
+    std::vector<AlgorithmRuns> algorithms;
+
+    // Multi-source mode: every run solves from each of these (empty otherwise)
+    std::vector<int> sources;
+    std::vector<int> reached;  // Vertices reached from each source
+    std::string sampling;      // "uniform" or "degree"
+
+    std::vector<std::pair<std::string, double>> load_phases_ms;  // parse
+    std::vector<std::pair<std::string, double>> preprocess_ms;   // CSR build (not solved on)
+
+    // How the runs were taken
+    int warmups = 0;
+    bool shuffled = false;     // Algorithm order randomized per run
+    uint32_t seed = 0;         // Seed of that order
+    bool cold_cache = false;   // Caches flushed before every timed solve
+    int pinned_cpu = -1;       // -1 if not pinned
+
+    const AlgorithmRuns* find(const std::string& name) const {
+        for (const auto& algorithm : algorithms) {
+            if (algorithm.name == name) return &algorithm;
+        }
+        return nullptr;
+    }
+};
+
+// FNV-1a over every (u, v, weight bits) in adjacency order
+template <typename GraphT>
+uint64_t graphFingerprint(const GraphT& graph) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value) {
+        for (int byte = 0; byte < 8; ++byte) {
+            hash = (hash ^ ((value >> (byte * 8)) & 0xff)) * 1099511628211ULL;
+        }
+    };
+    mix(static_cast<uint64_t>(graph.n));
+    for (int u = 0; u < graph.n; ++u) {
+        for (const auto& [v, w] : graph.outEdges(u)) {
+            uint64_t bits;
+            std::memcpy(&bits, &w, sizeof(bits));
+            mix((static_cast<uint64_t>(u) << 32) | static_cast<uint32_t>(v));
+            mix(bits);
+        }
+    }
+    return hash;
+}
+
+inline std::string fingerprintHex(uint64_t fingerprint) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(fingerprint));
+    return buffer;
+}
+
+inline void writeMemoryCounters(JsonWriter& json, const MemoryCounters& counters) {
+    json.beginObject();
+    json.key("allocated_bytes").value(counters.allocated_bytes);
+    json.key("allocations").value(counters.allocations);
+    json.key("live_bytes").value(counters.live_bytes);
+    json.key("peak_live_bytes").value(counters.peak_live_bytes);
+    json.endObject();
+}
+
+inline void writeJsonReport(const BenchmarkReport& report, std::ostream& out) {
+    JsonWriter json(out);
+    json.beginObject();
+    json.key("tool").value("sssp_benchmark");
+    json.key("format").value(1);
+
+    json.key("graph").beginObject();
+    json.key("path").value(report.graph_path);
+    json.key("n").value(report.n);
+    json.key("m").value(report.m);
+    json.key("directed").value(report.directed);
+    json.key("fingerprint").value(fingerprintHex(report.fingerprint));
+    json.endObject();
+    json.key("source").value(report.source);
+    if (!report.load_phases_ms.empty()) {
+        json.key("load_phases_ms").beginObject();
+        for (const auto& [phase, ms] : report.load_phases_ms) json.key(phase).value(ms);
+        json.endObject();
+    }
+    if (!report.preprocess_ms.empty()) {
+        json.key("preprocess_ms").beginObject();
+        for (const auto& [phase, ms] : report.preprocess_ms) json.key(phase).value(ms);
+        json.endObject();
+    }
+    if (!report.sources.empty()) {
+        json.key("sampling").value(report.sampling);
+        json.key("sources").beginArray();
+        for (int v : report.sources) json.value(v);
+        json.endArray();
+        json.key("reached").beginArray();
+        for (int r : report.reached) json.value(r);
+        json.endArray();
+    }
+
+    json.key("settings").beginObject();
+    json.key("warmups").value(report.warmups);
+    json.key("shuffled").value(report.shuffled);
+    json.key("seed").value(report.seed);
+    json.key("cold_cache").value(report.cold_cache);
+    json.key("pinned_cpu").value(report.pinned_cpu);
+    json.endObject();
+
+    json.key("algorithms").beginArray();
+    for (const auto& algorithm : report.algorithms) {
+        json.beginObject();
+        json.key("name").value(algorithm.name);
+
+        json.key("times_ms").beginArray();
+        for (double t : algorithm.times_ms) json.value(t);
+        json.endArray();
+
+        if (!algorithm.source_times_ms.empty()) {
+            json.key("source_times_ms").beginArray();
+            for (double t : algorithm.source_times_ms) json.value(t);
+            json.endArray();
+        }
+
+        if (!algorithm.phases_ms.empty()) {
+            json.key("phases_ms").beginObject();
+            for (const auto& [phase, ms] : algorithm.phases_ms) json.key(phase).value(ms);
+            json.endObject();
+        }
+
+        auto stats = BenchmarkStats::compute(algorithm.times_ms);
+        json.key("stats").beginObject();
+        json.key("mean").value(stats.mean);
+        json.key("median").value(stats.median);
+        json.key("std_dev").value(stats.std_dev);
+        json.key("min").value(stats.min);
+        json.key("max").value(stats.max);
+        json.key("q1").value(stats.q1);
+        json.key("q3").value(stats.q3);
+        json.key("outliers").value(stats.outliers);
+        json.endObject();
+
+        if (!algorithm.counters.empty()) {
+            json.key("counters").beginObject();
+            for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+                auto event = static_cast<PerfCounters::Event>(e);
+                if (!algorithm.counters.front().has(event)) continue;
+                json.key(PerfCounters::name(event)).beginArray();
+                for (const auto& sample : algorithm.counters) json.value(sample[event]);
+                json.endArray();
+            }
+            json.endObject();
+        }
+
+        if (algorithm.has_memory) {
+            const auto& memory = algorithm.memory;
+            json.key("memory").beginObject();
+            json.key("peak_rss_bytes").value(memory.peak_rss_bytes);
+            json.key("peak_rss_reset").value(memory.peak_rss_reset);
+            json.key("total");
+            writeMemoryCounters(json, memory.total);
+            json.key("categories").beginObject();
+            for (int c = 0; c < num_memory_categories; ++c) {
+                json.key(memoryCategoryName(static_cast<MemoryCategory>(c)));
+                writeMemoryCounters(json, memory.categories[c]);
+            }
+            json.endObject();
+            json.endObject();
+        }
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    out << "\n";
+}
+
+// One row per (algorithm, run); empty cells for counters that were not read
+inline void writeCsvReport(const BenchmarkReport& report, std::ostream& out) {
+    std::string graph = report.graph_path;
+    if (graph.find_first_of(",\"") != std::string::npos) {
+        std::string quoted = "\"";
+        for (char c : graph) quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+        graph = quoted + "\"";
+    }
+
+    out << "graph,fingerprint,n,m,source,algorithm,run,time_ms";
+    for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+        out << "," << PerfCounters::name(static_cast<PerfCounters::Event>(e));
+    }
+    out << "\n";
+
+    char number[32];
+    for (const auto& algorithm : report.algorithms) {
+        for (size_t run = 0; run < algorithm.times_ms.size(); ++run) {
+            std::snprintf(number, sizeof(number), "%.6f", algorithm.times_ms[run]);
+            out << graph << "," << fingerprintHex(report.fingerprint) << "," << report.n << ","
+                << report.m << "," << report.source << "," << algorithm.name << "," << run
+                << "," << number;
+            for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+                auto event = static_cast<PerfCounters::Event>(e);
+                out << ",";
+                if (run < algorithm.counters.size() && algorithm.counters[run].has(event)) {
+                    std::snprintf(number, sizeof(number), "%.0f", algorithm.counters[run][event]);
+                    out << number;
+                }
+            }
+            out << "\n";
+        }
+    }
+}
+
+// Graph identity and per-run times of a JSON report (the parts compare needs)
+inline BenchmarkReport readJsonReport(const std::string& path) {
+    JsonValue doc = JsonValue::parseFile(path);
+    if (doc["tool"].asString() != "sssp_benchmark") {
+        throw std::runtime_error("Not an sssp_benchmark report: " + path);
+    }
+
+    BenchmarkReport report;
+    const auto& graph = doc["graph"];
+    report.graph_path = graph["path"].asString();
+    report.n = static_cast<int>(graph["n"].asNumber());
+    report.m = static_cast<int>(graph["m"].asNumber());
+    report.directed = graph["directed"].asBool();
+    report.fingerprint = std::strtoull(graph["fingerprint"].asString().c_str(), nullptr, 16);
+    report.source = static_cast<int>(doc["source"].asNumber());
+    for (double v : doc["sources"].asNumbers()) report.sources.push_back(static_cast<int>(v));
+    for (const auto& entry : doc["algorithms"].items()) {
+        AlgorithmRuns algorithm;
+        algorithm.name = entry["name"].asString();
+        algorithm.times_ms = entry["times_ms"].asNumbers();
+        report.algorithms.push_back(std::move(algorithm));
+    }
+    return report;
+}
+
+struct BaselineComparison {
+    std::string name;
+    double baseline_median = 0;
+    double current_median = 0;
+    RatioEstimate ratio;       // current / baseline median time, with CI
+    bool regression = false;   // CI entirely above 1 + threshold
+    bool improvement = false;  // CI entirely below 1 - threshold
+};
+
+inline std::vector<BaselineComparison> compareToBaseline(const BenchmarkReport& current,
+                                                         const BenchmarkReport& baseline,
+                                                         double threshold,
+                                                         double confidence = 0.95) {
+    std::vector<BaselineComparison> result;
+    for (const auto& algorithm : current.algorithms) {
+        const AlgorithmRuns* base = baseline.find(algorithm.name);
+        if (!base || base->times_ms.empty() || algorithm.times_ms.empty()) continue;
+
+        BaselineComparison comparison;
+        comparison.name = algorithm.name;
+        comparison.baseline_median = median(base->times_ms);
+        comparison.current_median = median(algorithm.times_ms);
+        comparison.ratio = bootstrapMedianRatio(algorithm.times_ms, base->times_ms, confidence);
+        comparison.regression = comparison.ratio.low > 1.0 + threshold;
+        comparison.improvement = comparison.ratio.high < 1.0 - threshold;
+        result.push_back(comparison);
+    }
+    return result;
+}
+
+}  // namespace sssp
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <random>
+#include <cstdint>
+
+namespace sssp {
+
+// Summary of repeated timings
+struct BenchmarkStats {
+    double mean = 0;
+    double median = 0;
+    double std_dev = 0;
+    double min = 0;
+    double max = 0;
+    double q1 = 0;        // First quartile
+    double q3 = 0;        // Third quartile
+    size_t outliers = 0;  // Runs outside Tukey's fences, [q1 - 1.5 IQR, q3 + 1.5 IQR]
+
+    // Takes a copy, so the caller's per-run order is kept
+    static BenchmarkStats compute(std::vector<double> times) {
+        BenchmarkStats stats;
+
+        if (times.empty()) {
+            return stats;
+        }
+
+        std::sort(times.begin(), times.end());
+
+        stats.min = times.front();
+        stats.max = times.back();
+        stats.median = times[times.size() / 2];
+        stats.q1 = quantile(times, 0.25);
+        stats.q3 = quantile(times, 0.75);
+
+        double sum = std::accumulate(times.begin(), times.end(), 0.0);
+        stats.mean = sum / times.size();
+
+        double sq_sum = 0;
+        for (double t : times) {
+            sq_sum += (t - stats.mean) * (t - stats.mean);
+        }
+        stats.std_dev = std::sqrt(sq_sum / times.size());
+
+        double fence = 1.5 * (stats.q3 - stats.q1);
+        for (double t : times) {
+            if (t < stats.q1 - fence || t > stats.q3 + fence) stats.outliers++;
+        }
+
+        return stats;
+    }
+
+    // Linear interpolation between the closest ranks of sorted values
+    static double quantile(const std::vector<double>& sorted, double q) {
+        double position = q * (sorted.size() - 1);
+        size_t below = static_cast<size_t>(position);
+        size_t above = std::min(below + 1, sorted.size() - 1);
+        return sorted[below] + (position - below) * (sorted[above] - sorted[below]);
+    }
+};
+
+// Middle element (upper middle for even sizes, as BenchmarkStats::median)
+inline double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+/**
+ * median(numerator) / median(denominator) with a percentile bootstrap
+ * confidence interval: both samples are resampled with replacement,
+ * independently, `resamples` times. The fixed seed makes the interval
+ * reproducible for the same inputs.
+ */
+struct RatioEstimate {
+    double ratio = 0;
+    double low = 0;   // Lower end of the confidence interval
+    double high = 0;  // Upper end
+};
+
+inline RatioEstimate bootstrapMedianRatio(const std::vector<double>& numerator,
+                                          const std::vector<double>& denominator,
+                                          double confidence = 0.95, int resamples = 2000,
+                                          uint32_t seed = 66) {
+    RatioEstimate estimate;
+    if (numerator.empty() || denominator.empty()) return estimate;
+
+    double base = median(denominator);
+    estimate.ratio = base > 0 ? median(numerator) / base : 0.0;
+
+    std::mt19937 rng(seed);
+    std::vector<double> ratios;
+    ratios.reserve(resamples);
+    std::vector<double> a(numerator.size()), b(denominator.size());
+    std::uniform_int_distribution<size_t> pick_a(0, numerator.size() - 1);
+    std::uniform_int_distribution<size_t> pick_b(0, denominator.size() - 1);
+    for (int r = 0; r < resamples; ++r) {
+        for (double& x : a) x = numerator[pick_a(rng)];
+        for (double& x : b) x = denominator[pick_b(rng)];
+        double mb = median(b);
+        if (mb > 0) ratios.push_back(median(a) / mb);
+    }
+    if (ratios.empty()) return estimate;
+
+    std::sort(ratios.begin(), ratios.end());
+    double tail = (1.0 - confidence) / 2.0;
+    auto at = [&](double q) {
+        size_t index = static_cast<size_t>(q * (ratios.size() - 1) + 0.5);
+        return ratios[std::min(index, ratios.size() - 1)];
+    };
+    estimate.low = at(tail);
+    estimate.high = at(1.0 - tail);
+    return estimate;
+}
+
+}  // namespace sssp
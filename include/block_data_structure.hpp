@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <cstdint>
+#include <type_traits>
 
 namespace sssp {
 
@@ -16,23 +18,28 @@ namespace sssp {
  * - Insert: O(max{1, log(N/M)}) amortized
  * - BatchPrepend: O(L * max{1, log(L/M)}) amortized
  * - Pull: O(|S'|) amortized - returns M smallest elements
+ *
+ * Value is the distance type; BlockDataStructure stores doubles. A wrapped
+ * type (e.g. CountedDouble) observes every comparison, including those of
+ * the sorts and of the bound set.
  */
-class BlockDataStructure {
+template <typename Value = double>
+class BasicBlockDataStructure {
 public:
-    using KeyValue = std::pair<int, double>;  // (vertex_id, distance)
+    using KeyValue = std::pair<int, Value>;  // (vertex_id, distance)
 
 private:
     int M;           // Block size parameter
-    double B;        // Upper bound on values
+    Value B;         // Upper bound on values
     int N;           // Maximum expected insertions
 
     // Block structure: list of (key, value) pairs, sorted by value within block
     struct Block {
         std::list<KeyValue> elements;
-        double upper_bound;  // Upper bound for elements in this block
+        Value upper_bound;  // Upper bound for elements in this block
 
-        Block() : upper_bound(std::numeric_limits<double>::infinity()) {}
-        explicit Block(double ub) : upper_bound(ub) {}
+        Block() : upper_bound(std::numeric_limits<Value>::infinity()) {}
+        explicit Block(Value ub) : upper_bound(ub) {}
     };
 
     // D0: blocks from batch prepends (at front)
@@ -41,15 +48,15 @@ private:
     std::list<Block> D1;
 
     // Track which keys exist and their current value
-    std::map<int, double> key_values;
+    std::map<int, Value> key_values;
 
     // Upper bounds for D1 blocks (for binary search)
-    std::set<double> d1_upper_bounds;
+    std::set<Value> d1_upper_bounds;
 
 public:
-    BlockDataStructure() : M(1), B(std::numeric_limits<double>::infinity()), N(0) {}
+    BasicBlockDataStructure() : M(1), B(std::numeric_limits<Value>::infinity()), N(0) {}
 
-    void initialize(int m, double b, int max_n = 0) {
+    void initialize(int m, Value b, int max_n = 0) {
         M = std::max(1, m);
         B = b;
         N = max_n > 0 ? max_n : m * 10;
@@ -77,7 +84,7 @@ public:
         return key_values.size();
     }
 
-    void insert(int key, double value) {
+    void insert(int key, Value value) {
         // Check if key exists
         auto it = key_values.find(key);
         if (it != key_values.end()) {
@@ -105,7 +112,7 @@ public:
         if (items.empty()) return;
 
         // Remove duplicates, keeping smallest value per key
-        std::map<int, double> unique_items;
+        std::map<int, Value> unique_items;
         for (const auto& [key, value] : items) {
             auto it = unique_items.find(key);
             if (it == unique_items.end() || value < it->second) {
@@ -146,7 +153,8 @@ public:
             D0.push_front(new_block);
         } else {
             // Create multiple blocks
-            int num_blocks = (L + M / 2 - 1) / (M / 2);
+            int half = std::max(1, M / 2);  // M / 2 is 0 at the bottom level (M = 1)
+            int num_blocks = (L + half - 1) / half;
             int per_block = (L + num_blocks - 1) / num_blocks;
 
             std::list<Block> new_blocks;
@@ -168,29 +176,13 @@ public:
     }
 
     // Pull returns up to M smallest elements and the separating bound
-    std::pair<std::vector<int>, double> pull() {
+    std::pair<std::vector<int>, Value> pull() {
         std::vector<KeyValue> candidates;
-        double sep_bound = B;
+        Value sep_bound = B;
 
-        // Collect from D0
-        int collected_d0 = 0;
-        for (auto& block : D0) {
-            for (const auto& elem : block.elements) {
-                candidates.push_back(elem);
-                collected_d0++;
-            }
-            if (collected_d0 >= M) break;
-        }
-
-        // Collect from D1
-        int collected_d1 = 0;
-        for (auto& block : D1) {
-            for (const auto& elem : block.elements) {
-                candidates.push_back(elem);
-                collected_d1++;
-            }
-            if (collected_d1 >= M) break;
-        }
+        // Collect the leading blocks of D0 and of D1, at least M elements each
+        auto d0_end = collect(D0, candidates);
+        auto d1_end = collect(D1, candidates);
 
         if (candidates.empty()) {
             return {{}, B};
@@ -214,44 +206,59 @@ public:
             removeKey(candidates[i].first);
         }
 
-        // Determine separator bound
+        // The separator is the smallest value left: the first candidate not
+        // taken, or an element of a block past either scanned prefix. Blocks
+        // are ordered, so only the first non-empty one of each list can hold
+        // it; the (M + 1)-th candidate alone can exceed it.
         if (static_cast<int>(candidates.size()) > take) {
             sep_bound = candidates[take].second;
-        } else if (empty()) {
-            sep_bound = B;
-        } else {
-            // Find minimum remaining value
-            sep_bound = B;
-            for (const auto& block : D0) {
-                for (const auto& elem : block.elements) {
-                    sep_bound = std::min(sep_bound, elem.second);
-                }
-            }
-            for (const auto& block : D1) {
-                for (const auto& elem : block.elements) {
-                    sep_bound = std::min(sep_bound, elem.second);
-                }
-            }
         }
+        sep_bound = std::min(sep_bound, firstBlockMin(d0_end, D0.end()));
+        sep_bound = std::min(sep_bound, firstBlockMin(d1_end, D1.end()));
 
         return {result, sep_bound};
     }
 
     // Get value for a key (for debugging/testing)
-    double getValue(int key) const {
+    Value getValue(int key) const {
         auto it = key_values.find(key);
         if (it != key_values.end()) {
             return it->second;
         }
-        return std::numeric_limits<double>::infinity();
+        return std::numeric_limits<Value>::infinity();
     }
 
 private:
+    using BlockIterator = typename std::list<Block>::iterator;
+
+    // Appends the elements of the leading blocks until at least M were
+    // collected; returns the first block not scanned
+    BlockIterator collect(std::list<Block>& blocks, std::vector<KeyValue>& out) {
+        int collected = 0;
+        auto it = blocks.begin();
+        for (; it != blocks.end() && collected < M; ++it) {
+            out.insert(out.end(), it->elements.begin(), it->elements.end());
+            collected += static_cast<int>(it->elements.size());
+        }
+        return it;
+    }
+
+    // Smallest value in the first non-empty block of [it, end), B if none
+    Value firstBlockMin(BlockIterator it, BlockIterator end) const {
+        for (; it != end; ++it) {
+            if (it->elements.empty()) continue;
+            Value smallest = B;
+            for (const auto& elem : it->elements) smallest = std::min(smallest, elem.second);
+            return smallest;
+        }
+        return B;
+    }
+
     void removeKey(int key) {
         auto kv_it = key_values.find(key);
         if (kv_it == key_values.end()) return;
 
-        double value = kv_it->second;
+        Value value = kv_it->second;
         key_values.erase(kv_it);
 
         // Remove from D0
@@ -275,7 +282,7 @@ private:
         }
     }
 
-    std::list<Block>::iterator findBlockForValue(double value) {
+    typename std::list<Block>::iterator findBlockForValue(Value value) {
         // Find block in D1 with smallest upper_bound >= value
         for (auto it = D1.begin(); it != D1.end(); ++it) {
             if (it->upper_bound >= value) {
@@ -286,7 +293,7 @@ private:
         return std::prev(D1.end());
     }
 
-    void splitBlock(std::list<Block>::iterator block_it) {
+    void splitBlock(typename std::list<Block>::iterator block_it) {
         auto& block = *block_it;
         if (static_cast<int>(block.elements.size()) <= M) return;
 
@@ -321,4 +328,430 @@ private:
     }
 };
 
+using BlockDataStructure = BasicBlockDataStructure<>;
+
+// Counters of the lazy block structures since initialize(); summed over
+// BMSSP calls by the solver
+struct LazyBlockStats {
+    size_t entries = 0;        // Entries written (insert + batchPrepend)
+    size_t stale_entries = 0;  // Entries superseded by a smaller value
+    size_t compactions = 0;    // Full passes dropping stale entries
+
+    LazyBlockStats& operator+=(const LazyBlockStats& other) {
+        entries += other.entries;
+        stale_entries += other.stale_entries;
+        compactions += other.compactions;
+        return *this;
+    }
+
+    double staleRatio() const {
+        return entries == 0 ? 0.0 : static_cast<double>(stale_entries) / entries;
+    }
+};
+
+namespace detail {
+
+struct LazyEntry {
+    int key;
+    double value;
+    uint32_t stamp;
+};
+
+// Block storage for compile-time M: at most Capacity entries inline, no heap
+// allocation. Offers the few vector operations the lazy structure needs.
+template <int Capacity>
+class InlineEntries {
+public:
+    using iterator = LazyEntry*;
+    using const_iterator = const LazyEntry*;
+
+    iterator begin() { return items; }
+    iterator end() { return items + count; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    LazyEntry& operator[](size_t i) { return items[i]; }
+
+    void push_back(const LazyEntry& e) { items[count++] = e; }
+
+    template <typename It>
+    void assign(It first, It last) {
+        count = 0;
+        for (; first != last; ++first) items[count++] = *first;
+    }
+
+    iterator erase(iterator first, iterator last) {
+        iterator out = std::move(last, end(), first);
+        count = static_cast<int>(out - items);
+        return first;
+    }
+
+private:
+    LazyEntry items[Capacity];
+    int count = 0;
+};
+
+// Batcher's odd-even merge sort on all N slots by value. N is a
+// compile-time constant, so the loops unroll into a fixed sequence of
+// branch-free compare-exchanges.
+template <int N>
+inline void sortingNetwork(LazyEntry* a) {
+    for (int p = 1; p < N; p <<= 1) {
+        for (int k = p; k >= 1; k >>= 1) {
+            for (int j = k % p; j + k < N; j += 2 * k) {
+                for (int i = 0; i < std::min(k, N - j - k); ++i) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        LazyEntry& x = a[i + j];
+                        LazyEntry& y = a[i + j + k];
+                        bool swap = y.value < x.value;
+                        LazyEntry lo = swap ? y : x;
+                        LazyEntry hi = swap ? x : y;
+                        x = lo;
+                        y = hi;
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * BlockDataStructure with lazy deletion.
+ *
+ * Same blocks, bounds and pull rule as BlockDataStructure, but improving a
+ * key does not search the lists for its old entry. Every entry carries the
+ * generation stamp it was written with; the key's current stamp lives in
+ * key_values, so an older entry is stale and is dropped when a pull or a
+ * split passes over it. When stale entries outnumber live keys, all blocks
+ * are compacted at once. Blocks are plain vectors since nothing is ever
+ * erased from the middle.
+ *
+ * FixedM > 0 fixes the block size at compile time (the M passed to
+ * initialize() is then ignored): blocks are inline arrays of M + 1 entries
+ * and are sorted with a sorting network when they split. BMSSP switches to
+ * these for small M through the Fixed alias (see has_fixed_block_sizes);
+ * BlockDataStructure has no such variant, so the default NewSSSP does not.
+ */
+template <int FixedM = 0>
+class BasicLazyBlockDataStructure {
+public:
+    using KeyValue = std::pair<int, double>;  // (vertex_id, distance)
+    using Stats = LazyBlockStats;
+
+    template <int M>
+    using Fixed = BasicLazyBlockDataStructure<M>;
+
+private:
+    using Entry = detail::LazyEntry;
+
+    struct Slot {
+        double value;
+        uint32_t stamp;
+    };
+
+    // A block never holds more than M + 1 entries: inserts split it above M,
+    // batchPrepend creates blocks of at most M
+    using Entries = std::conditional_t<FixedM == 0, std::vector<Entry>,
+                                       detail::InlineEntries<FixedM + 1>>;
+
+    struct Block {
+        Entries elements;
+        double upper_bound;
+
+        Block() : upper_bound(std::numeric_limits<double>::infinity()) {}
+        explicit Block(double ub) : upper_bound(ub) {}
+    };
+
+    using BlockList = std::list<Block>;
+
+    int M;
+    double B;
+    int N;
+
+    BlockList D0;
+    BlockList D1;
+
+    std::map<int, Slot> key_values;  // Current value and stamp of every live key
+    uint32_t next_stamp = 0;
+    size_t stale_in_blocks = 0;      // Stale entries not yet dropped
+    Stats stats_;
+
+public:
+    BasicLazyBlockDataStructure()
+        : M(FixedM > 0 ? FixedM : 1), B(std::numeric_limits<double>::infinity()), N(0) {}
+
+    void initialize(int m, double b, int max_n = 0) {
+        M = FixedM > 0 ? FixedM : std::max(1, m);
+        B = b;
+        N = max_n > 0 ? max_n : m * 10;
+        D0.clear();
+        D1.clear();
+        key_values.clear();
+        next_stamp = 0;
+        stale_in_blocks = 0;
+        stats_ = Stats();
+
+        D1.emplace_back(B);
+    }
+
+    bool empty() const { return key_values.empty(); }
+
+    size_t size() const { return key_values.size(); }
+
+    void insert(int key, double value) {
+        uint32_t stamp;
+        if (!claim(key, value, stamp)) return;
+
+        auto block_it = findBlockForValue(value);
+        block_it->elements.push_back({key, value, stamp});
+
+        if (static_cast<int>(block_it->elements.size()) > blockSize()) {
+            splitBlock(block_it);
+        }
+        maybeCompact();
+    }
+
+    void batchPrepend(std::vector<KeyValue>& items) {
+        if (items.empty()) return;
+
+        // Smallest value per key within the batch
+        std::map<int, double> unique_items;
+        for (const auto& [key, value] : items) {
+            auto it = unique_items.find(key);
+            if (it == unique_items.end() || value < it->second) {
+                unique_items[key] = value;
+            }
+        }
+
+        std::vector<Entry> to_add;
+        for (const auto& [key, value] : unique_items) {
+            uint32_t stamp;
+            if (claim(key, value, stamp)) {
+                to_add.push_back({key, value, stamp});
+            }
+        }
+
+        if (to_add.empty()) return;
+
+        std::sort(to_add.begin(), to_add.end(),
+                  [](const Entry& a, const Entry& b) { return a.value < b.value; });
+
+        int L = static_cast<int>(to_add.size());
+        if (L <= blockSize()) {
+            Block new_block(to_add.back().value);
+            new_block.elements.assign(to_add.begin(), to_add.end());
+            D0.push_front(std::move(new_block));
+        } else {
+            int half = std::max(1, blockSize() / 2);
+            int num_blocks = (L + half - 1) / half;
+            int per_block = (L + num_blocks - 1) / num_blocks;
+
+            BlockList new_blocks;
+            for (int i = 0; i < L; i += per_block) {
+                int end = std::min(i + per_block, L);
+                Block block(to_add[end - 1].value);
+                block.elements.assign(to_add.begin() + i, to_add.begin() + end);
+                new_blocks.push_back(std::move(block));
+            }
+            D0.splice(D0.begin(), new_blocks);
+        }
+        maybeCompact();
+    }
+
+    // Pull returns up to M smallest elements and the separating bound
+    std::pair<std::vector<int>, double> pull() {
+        std::vector<Entry> candidates;
+        auto d0_end = collect(D0, candidates, true);
+        auto d1_end = collect(D1, candidates, false);
+
+        if (candidates.empty()) {
+            return {{}, B};
+        }
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Entry& a, const Entry& b) { return a.value < b.value; });
+
+        int take = std::min(blockSize(), static_cast<int>(candidates.size()));
+        std::vector<int> result;
+        result.reserve(take);
+        for (int i = 0; i < take; ++i) {
+            result.push_back(candidates[i].key);
+            key_values.erase(candidates[i].key);
+        }
+
+        // Taken entries are now stale; drop them from the blocks just scanned
+        dropStale(D0, d0_end, true);
+        dropStale(D1, d1_end, false);
+
+        // Smallest value left, as in BlockDataStructure::pull
+        double sep_bound = B;
+        if (static_cast<int>(candidates.size()) > take) {
+            sep_bound = candidates[take].value;
+        }
+        sep_bound = std::min(sep_bound, firstBlockMin(d0_end, D0.end()));
+        sep_bound = std::min(sep_bound, firstBlockMin(d1_end, D1.end()));
+
+        return {result, sep_bound};
+    }
+
+    double getValue(int key) const {
+        auto it = key_values.find(key);
+        if (it != key_values.end()) {
+            return it->second.value;
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    int blockSize() const {
+        if constexpr (FixedM > 0) {
+            return FixedM;
+        } else {
+            return M;
+        }
+    }
+
+    bool isLive(const Entry& e) const {
+        auto it = key_values.find(e.key);
+        return it != key_values.end() && it->second.stamp == e.stamp;
+    }
+
+    // Record value for key if it is new or smaller; the previous entry, if
+    // any, goes stale. Returns false if the existing value is kept.
+    bool claim(int key, double value, uint32_t& stamp) {
+        auto it = key_values.find(key);
+        if (it != key_values.end()) {
+            if (value >= it->second.value) return false;
+            stale_in_blocks++;
+            stats_.stale_entries++;
+        }
+        stamp = next_stamp++;
+        key_values[key] = {value, stamp};
+        stats_.entries++;
+        return true;
+    }
+
+    // Append the live entries of the leading blocks to out, dropping stale
+    // ones on the way, until at least M were collected.
+    // Returns the end of the scanned range.
+    typename BlockList::iterator collect(BlockList& blocks, std::vector<Entry>& out,
+                                         bool erase_empty) {
+        int collected = 0;
+        auto it = blocks.begin();
+        while (it != blocks.end() && collected < blockSize()) {
+            dropStaleEntries(*it);
+            if (erase_empty && it->elements.empty()) {
+                it = blocks.erase(it);
+                continue;
+            }
+            out.insert(out.end(), it->elements.begin(), it->elements.end());
+            collected += static_cast<int>(it->elements.size());
+            ++it;
+        }
+        return it;
+    }
+
+    // Smallest live value in the first block of [it, end) holding one, B if none
+    double firstBlockMin(typename BlockList::iterator it, typename BlockList::iterator end) const {
+        for (; it != end; ++it) {
+            double smallest = B;
+            bool live = false;
+            for (const auto& e : it->elements) {
+                if (isLive(e)) {
+                    smallest = std::min(smallest, e.value);
+                    live = true;
+                }
+            }
+            if (live) return smallest;
+        }
+        return B;
+    }
+
+    void dropStale(BlockList& blocks, typename BlockList::iterator end, bool erase_empty) {
+        for (auto it = blocks.begin(); it != end;) {
+            auto& elems = it->elements;
+            elems.erase(std::remove_if(elems.begin(), elems.end(),
+                                       [this](const Entry& e) { return !isLive(e); }),
+                        elems.end());
+            if (erase_empty && elems.empty()) {
+                it = blocks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Drop superseded entries of one block (not those removed by pull)
+    void dropStaleEntries(Block& block) {
+        auto& elems = block.elements;
+        size_t before = elems.size();
+        elems.erase(std::remove_if(elems.begin(), elems.end(),
+                                   [this](const Entry& e) { return !isLive(e); }),
+                    elems.end());
+        stale_in_blocks -= std::min(stale_in_blocks, before - elems.size());
+    }
+
+    void maybeCompact() {
+        if (stale_in_blocks <= key_values.size() ||
+            stale_in_blocks < static_cast<size_t>(blockSize())) {
+            return;
+        }
+        for (auto it = D0.begin(); it != D0.end();) {
+            dropStaleEntries(*it);
+            it = it->elements.empty() ? D0.erase(it) : std::next(it);
+        }
+        for (auto& block : D1) {
+            dropStaleEntries(block);
+        }
+        stale_in_blocks = 0;
+        stats_.compactions++;
+    }
+
+    typename BlockList::iterator findBlockForValue(double value) {
+        for (auto it = D1.begin(); it != D1.end(); ++it) {
+            if (it->upper_bound >= value) {
+                return it;
+            }
+        }
+        return std::prev(D1.end());
+    }
+
+    void sortBlock(Entries& elems) {
+        if constexpr (FixedM > 0) {
+            // A splitting block is full: exactly FixedM + 1 entries
+            detail::sortingNetwork<FixedM + 1>(elems.begin());
+        } else {
+            std::sort(elems.begin(), elems.end(),
+                      [](const Entry& a, const Entry& b) { return a.value < b.value; });
+        }
+    }
+
+    void splitBlock(typename BlockList::iterator block_it) {
+        dropStaleEntries(*block_it);
+        auto& elems = block_it->elements;
+        if (static_cast<int>(elems.size()) <= blockSize()) return;
+
+        sortBlock(elems);
+        size_t mid = elems.size() / 2;
+
+        Block lower(elems[mid - 1].value);
+        lower.elements.assign(elems.begin(), elems.begin() + mid);
+        elems.erase(elems.begin(), elems.begin() + mid);
+
+        // block_it keeps the upper half and its bound
+        D1.insert(block_it, std::move(lower));
+    }
+};
+
+using LazyBlockDataStructure = BasicLazyBlockDataStructure<>;
+
+// Compile-time block size variant of LazyBlockDataStructure
+template <int M>
+using FixedBlockDataStructure = BasicLazyBlockDataStructure<M>;
+
 }  // namespace sssp
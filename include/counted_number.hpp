@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace sssp {
+
+/**
+ * Operation counts in the comparison-addition model: additions (and
+ * subtractions) of distances and weights, and comparisons between them.
+ * Counted per thread.
+ */
+struct OperationCounts {
+    uint64_t additions = 0;
+    uint64_t comparisons = 0;
+
+    uint64_t total() const { return additions + comparisons; }
+
+    OperationCounts& operator+=(const OperationCounts& other) {
+        additions += other.additions;
+        comparisons += other.comparisons;
+        return *this;
+    }
+
+    friend OperationCounts operator-(OperationCounts a, const OperationCounts& b) {
+        a.additions -= b.additions;
+        a.comparisons -= b.comparisons;
+        return a;
+    }
+};
+
+// Running totals of the calling thread
+inline OperationCounts& operationCounts() {
+    thread_local OperationCounts counts;
+    return counts;
+}
+
+// Operations performed by f() on the calling thread
+template <typename F>
+OperationCounts countOperations(F&& f) {
+    OperationCounts before = operationCounts();
+    f();
+    return operationCounts() - before;
+}
+
+/**
+ * A number that counts every addition and comparison made with it.
+ *
+ * Construction from T is implicit, so literals, stored distances and edge
+ * weights mix freely with counted values; any operation with a Counted
+ * operand is counted. Conversion back is explicit (static_cast<T>), so an
+ * uncounted operation cannot happen by accident. Containers and algorithms
+ * keyed on Counted (std::priority_queue, std::sort, std::set) count their
+ * comparisons too.
+ *
+ *     CountedDouble d = 1.5;
+ *     auto ops = countOperations([&] { d = d + 2.0; bool less = d < 4.0; (void)less; });
+ *     // ops.additions == 1, ops.comparisons == 1
+ */
+template <typename T>
+class Counted {
+public:
+    Counted() = default;
+    Counted(T value) : v(value) {}
+
+    explicit operator T() const { return v; }
+    T value() const { return v; }
+
+    Counted& operator+=(Counted other) {
+        ++operationCounts().additions;
+        v += other.v;
+        return *this;
+    }
+
+    friend Counted operator+(Counted a, Counted b) { return a += b; }
+
+    // Subtraction is an addition in the model
+    friend Counted operator-(Counted a, Counted b) {
+        ++operationCounts().additions;
+        return Counted(a.v - b.v);
+    }
+
+    friend bool operator<(Counted a, Counted b) { return compared(a.v < b.v); }
+    friend bool operator<=(Counted a, Counted b) { return compared(a.v <= b.v); }
+    friend bool operator>(Counted a, Counted b) { return compared(a.v > b.v); }
+    friend bool operator>=(Counted a, Counted b) { return compared(a.v >= b.v); }
+    friend bool operator==(Counted a, Counted b) { return compared(a.v == b.v); }
+    friend bool operator!=(Counted a, Counted b) { return compared(a.v != b.v); }
+
+private:
+    static bool compared(bool result) {
+        ++operationCounts().comparisons;
+        return result;
+    }
+
+    T v{};
+};
+
+using CountedDouble = Counted<double>;
+
+}  // namespace sssp
+
+// Limits of the wrapped type (infinity() etc.), so generic code can use
+// std::numeric_limits<Value> for either
+template <typename T>
+class std::numeric_limits<sssp::Counted<T>> : public std::numeric_limits<T> {};
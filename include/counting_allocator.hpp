@@ -0,0 +1,143 @@
+#pragma once
+
+/**
+ * Replacement global operator new/delete that feed MemoryTracker.
+ *
+ * Include this header in exactly one translation unit of a program; the
+ * operators are not inline, so a second inclusion fails to link.
+ *
+ * Every block carries a small header in front of it with the requested
+ * size, the category it was charged to and whether it was counted. Frees
+ * use the header, so a block allocated while counting was off is never
+ * subtracted. The header is max(16, alignment) bytes.
+ */
+
+#include "memory_tracker.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace sssp {
+namespace detail {
+
+struct AllocationHeader {
+    size_t size;
+    MemoryCategory category;
+    bool counted;
+};
+
+constexpr size_t default_header_size = 16;
+static_assert(sizeof(AllocationHeader) <= default_header_size, "header must fit its slot");
+
+inline void* countedAllocate(size_t size, size_t alignment) {
+    size_t offset = alignment > default_header_size ? alignment : default_header_size;
+    void* base = nullptr;
+    if (alignment > default_header_size) {
+        // aligned_alloc needs a size that is a multiple of the alignment
+        size_t total = (size + offset + alignment - 1) / alignment * alignment;
+        base = std::aligned_alloc(alignment, total);
+    } else {
+        base = std::malloc(size + offset);
+    }
+    if (!base) return nullptr;
+
+    char* user = static_cast<char*>(base) + offset;
+    auto* header = reinterpret_cast<AllocationHeader*>(user - sizeof(AllocationHeader));
+    header->size = size;
+    header->category = MemoryTracker::current();
+    header->counted = MemoryTracker::isEnabled();
+    if (header->counted) {
+        MemoryTracker::recordAllocation(header->category, size);
+    }
+    return user;
+}
+
+inline void countedFree(void* ptr, size_t alignment) {
+    if (!ptr) return;
+    size_t offset = alignment > default_header_size ? alignment : default_header_size;
+    char* user = static_cast<char*>(ptr);
+    auto* header = reinterpret_cast<AllocationHeader*>(user - sizeof(AllocationHeader));
+    if (header->counted) {
+        MemoryTracker::recordFree(header->category, header->size);
+    }
+    std::free(user - offset);
+}
+
+inline void* countedNew(size_t size, size_t alignment) {
+    for (;;) {
+        if (void* ptr = countedAllocate(size, alignment)) return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+inline void* countedNewNothrow(size_t size, size_t alignment) noexcept {
+    try {
+        return countedNew(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+// Registers the allocator with MemoryTracker before main()
+struct CountingAllocatorRegistration {
+    CountingAllocatorRegistration() { MemoryTracker::markInstalled(); }
+};
+static CountingAllocatorRegistration counting_allocator_registration;
+
+}  // namespace detail
+}  // namespace sssp
+
+#define SSSP_DEFAULT_ALIGNMENT __STDCPP_DEFAULT_NEW_ALIGNMENT__
+
+void* operator new(size_t size) { return sssp::detail::countedNew(size, SSSP_DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size) { return sssp::detail::countedNew(size, SSSP_DEFAULT_ALIGNMENT); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return sssp::detail::countedNewNothrow(size, SSSP_DEFAULT_ALIGNMENT);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return sssp::detail::countedNewNothrow(size, SSSP_DEFAULT_ALIGNMENT);
+}
+void* operator new(size_t size, std::align_val_t align) {
+    return sssp::detail::countedNew(size, static_cast<size_t>(align));
+}
+void* operator new[](size_t size, std::align_val_t align) {
+    return sssp::detail::countedNew(size, static_cast<size_t>(align));
+}
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return sssp::detail::countedNewNothrow(size, static_cast<size_t>(align));
+}
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return sssp::detail::countedNewNothrow(size, static_cast<size_t>(align));
+}
+
+void operator delete(void* ptr) noexcept { sssp::detail::countedFree(ptr, SSSP_DEFAULT_ALIGNMENT); }
+void operator delete[](void* ptr) noexcept { sssp::detail::countedFree(ptr, SSSP_DEFAULT_ALIGNMENT); }
+void operator delete(void* ptr, size_t) noexcept { sssp::detail::countedFree(ptr, SSSP_DEFAULT_ALIGNMENT); }
+void operator delete[](void* ptr, size_t) noexcept { sssp::detail::countedFree(ptr, SSSP_DEFAULT_ALIGNMENT); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    sssp::detail::countedFree(ptr, SSSP_DEFAULT_ALIGNMENT);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    sssp::detail::countedFree(ptr, SSSP_DEFAULT_ALIGNMENT);
+}
+void operator delete(void* ptr, std::align_val_t align) noexcept {
+    sssp::detail::countedFree(ptr, static_cast<size_t>(align));
+}
+void operator delete[](void* ptr, std::align_val_t align) noexcept {
+    sssp::detail::countedFree(ptr, static_cast<size_t>(align));
+}
+void operator delete(void* ptr, size_t, std::align_val_t align) noexcept {
+    sssp::detail::countedFree(ptr, static_cast<size_t>(align));
+}
+void operator delete[](void* ptr, size_t, std::align_val_t align) noexcept {
+    sssp::detail::countedFree(ptr, static_cast<size_t>(align));
+}
+void operator delete(void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept {
+    sssp::detail::countedFree(ptr, static_cast<size_t>(align));
+}
+void operator delete[](void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept {
+    sssp::detail::countedFree(ptr, static_cast<size_t>(align));
+}
+
+#undef SSSP_DEFAULT_ALIGNMENT
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "graph_types.hpp"
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace sssp {
+
+/**
+ * Compressed sparse row (CSR) graph: all out-edges in one contiguous array,
+ * indexed by per-vertex offsets.
+ *
+ * With sort_by_weight, each adjacency list is sorted by ascending weight.
+ * The bounded relax loops of NewSSSP (BMSSP, baseCase, findPivots) then stop
+ * scanning u's edges at the first one with d_hat[u] + w >= B, since every
+ * later edge exceeds the bound too.
+ */
+struct CSRGraph {
+    using Edge = std::pair<int, double>;
+
+    // Contiguous range of out-edges of one vertex
+    struct EdgeSpan {
+        const Edge* first;
+        const Edge* last;
+
+        const Edge* begin() const { return first; }
+        const Edge* end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+    };
+
+    int n = 0;  // number of nodes
+    int m = 0;  // number of edges
+    std::vector<size_t> offsets;  // n + 1 entries; edges of u are [offsets[u], offsets[u+1])
+    std::vector<Edge> edges;      // (target, weight)
+    bool weight_sorted = false;   // Each adjacency list sorted by ascending weight
+
+    CSRGraph() = default;
+
+    explicit CSRGraph(const SimpleGraph& g, bool sort_by_weight = false)
+        : n(g.n), m(g.m), offsets(g.n + 1, 0), weight_sorted(sort_by_weight) {
+        for (int u = 0; u < n; ++u) {
+            offsets[u + 1] = offsets[u] + g.adj[u].size();
+        }
+        edges.reserve(offsets[n]);
+        for (int u = 0; u < n; ++u) {
+            edges.insert(edges.end(), g.adj[u].begin(), g.adj[u].end());
+            if (sort_by_weight) {
+                // Stable so equal weights keep their insertion order
+                std::stable_sort(edges.begin() + offsets[u], edges.end(),
+                                 [](const Edge& a, const Edge& b) { return a.second < b.second; });
+            }
+        }
+    }
+
+    EdgeSpan outEdges(int u) const {
+        return {edges.data() + offsets[u], edges.data() + offsets[u + 1]};
+    }
+
+    int outDegree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+};
+
+template <>
+inline constexpr bool supports_weight_cutoff<CSRGraph> = true;
+
+}  // namespace sssp
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "graph_types.hpp"
+#include "solver_policy.hpp"
+#include "solver_visitor.hpp"
+#include "trace_recorder.hpp"
+#include "memory_tracker.hpp"
 #include <lemon/dijkstra.h>
 #include <vector>
+#include <queue>
+#include <algorithm>
 
 namespace sssp {
 
@@ -11,6 +17,8 @@ namespace sssp {
  */
 class DijkstraLemon {
 public:
+    using Engine = lemon::Dijkstra<Graph, WeightMap>;
+
     struct Result {
         std::vector<double> distances;
         std::vector<int> predecessors;
@@ -20,47 +28,73 @@ public:
     static Result solve(const Graph& graph, const WeightMap& weights, Node source) {
         int n = lemon::countNodes(graph);
         Result result;
-        result.distances.resize(n, INF);
-        result.predecessors.resize(n, -1);
+        {
+            SSSP_MEMORY_SCOPE(Results);
+            result.distances.resize(n);
+            result.predecessors.resize(n);
+        }
         result.source = graph.id(source);
+        solve(graph, weights, source, result.distances.data(), result.predecessors.data());
+        return result;
+    }
 
+    // Solve into caller-provided spans of at least countNodes(graph) entries
+    static void solve(const Graph& graph, const WeightMap& weights, Node source,
+                      double* distances, int* predecessors) {
+        SSSP_TRACE_SCOPE("DijkstraLemon::solve", "dijkstra");
+        SSSP_MEMORY_SCOPE(Workspace);
         // Use LEMON's Dijkstra
-        lemon::Dijkstra<Graph, WeightMap> dijkstra(graph, weights);
+        Engine dijkstra(graph, weights);
         dijkstra.run(source);
+        extract(graph, dijkstra, distances, predecessors);
+    }
 
-        // Extract results
+    // Copy distances and predecessors out of a finished run (INF / -1 if unreached)
+    static void extract(const Graph& graph, const Engine& dijkstra,
+                        double* distances, int* predecessors) {
         for (Graph::NodeIt v(graph); v != lemon::INVALID; ++v) {
             int v_id = graph.id(v);
+            distances[v_id] = INF;
+            predecessors[v_id] = -1;
             if (dijkstra.reached(v)) {
-                result.distances[v_id] = dijkstra.dist(v);
+                distances[v_id] = dijkstra.dist(v);
                 if (dijkstra.predArc(v) != lemon::INVALID) {
-                    result.predecessors[v_id] = graph.id(graph.source(dijkstra.predArc(v)));
+                    predecessors[v_id] = graph.id(graph.source(dijkstra.predArc(v)));
                 }
             }
         }
-
-        return result;
     }
 
-    // Solve using SimpleGraph format
-    static Result solve(const SimpleGraph& graph, int source) {
-        // Convert SimpleGraph to LEMON graph
-        Graph lemon_graph;
-        WeightMap weights(lemon_graph);
-
+    // Copy a SimpleGraph (or any graph view with outEdges()) into an empty
+    // LEMON graph; returns the LEMON node of each vertex. The length map may
+    // hold another value type than double (e.g. CountedDouble).
+    template <typename GraphT, typename LengthMap = WeightMap>
+    static std::vector<Node> buildGraph(const GraphT& graph, Graph& lemon_graph,
+                                        LengthMap& weights) {
+        SSSP_TRACE_SCOPE("DijkstraLemon::buildGraph", "dijkstra", "n", graph.n);
         std::vector<Node> nodes;
         nodes.reserve(graph.n);
-
         for (int i = 0; i < graph.n; ++i) {
             nodes.push_back(lemon_graph.addNode());
         }
 
         for (int u = 0; u < graph.n; ++u) {
-            for (const auto& [v, w] : graph.adj[u]) {
+            for (const auto& [v, w] : graph.outEdges(u)) {
                 Arc arc = lemon_graph.addArc(nodes[u], nodes[v]);
                 weights[arc] = w;
             }
         }
+        return nodes;
+    }
+
+    // Solve using SimpleGraph format (or any graph view with outEdges())
+    template <typename GraphT>
+    static Result solve(const GraphT& graph, int source) {
+        // Convert SimpleGraph to LEMON graph
+        SSSP_MEMORY_SCOPE(Workspace);
+        Graph lemon_graph;
+        WeightMap weights(lemon_graph);
+        std::vector<Node> nodes = buildGraph(graph, lemon_graph, weights);
 
         return solve(lemon_graph, weights, nodes[source]);
     }
@@ -69,6 +103,13 @@ public:
 /**
  * Simple Dijkstra implementation for comparison (without LEMON)
  * Uses std::priority_queue with Fibonacci-heap-like behavior
+ *
+ * The Policy template argument (solver_policy.hpp) controls predecessor
+ * tracking; with DistanceOnlyPolicy no predecessor array is written. Its
+ * distance type is used for the relaxations and the heap entries.
+ * The visitor overloads report discover/relax/settle events and can prune
+ * or stop the search (solver_visitor.hpp). Any graph with n and outEdges(u)
+ * works, e.g. SimpleGraph or FilteredGraph.
  */
 class SimpleDijkstra {
 public:
@@ -78,39 +119,129 @@ public:
         int source;
     };
 
-    static Result solve(const SimpleGraph& graph, int source) {
-        int n = graph.n;
+    template <typename Policy = DefaultPolicy, typename GraphT>
+    static Result solve(const GraphT& graph, int source) {
+        Result result;
+        {
+            SSSP_MEMORY_SCOPE(Results);
+            result.distances.resize(graph.n);
+            if constexpr (Policy::track_predecessors) {
+                result.predecessors.resize(graph.n);
+            }
+        }
+        result.source = source;
+        solve<Policy>(graph, source, result.distances.data(), result.predecessors.data());
+        return result;
+    }
+
+    template <typename Policy = DefaultPolicy, typename GraphT, typename Visitor>
+    static Result solve(const GraphT& graph, int source, Visitor& visitor) {
         Result result;
-        result.distances.assign(n, INF);
-        result.predecessors.assign(n, -1);
+        {
+            SSSP_MEMORY_SCOPE(Results);
+            result.distances.resize(graph.n);
+            if constexpr (Policy::track_predecessors) {
+                result.predecessors.resize(graph.n);
+            }
+        }
         result.source = source;
+        solve<Policy>(graph, source, result.distances.data(), result.predecessors.data(), visitor);
+        return result;
+    }
+
+    // Solve into caller-owned vectors, reusing their capacity across queries
+    template <typename Policy = DefaultPolicy, typename GraphT>
+    static void solve(const GraphT& graph, int source,
+                      std::vector<double>& distances, std::vector<int>& predecessors) {
+        distances.resize(graph.n);
+        if constexpr (Policy::track_predecessors) {
+            predecessors.resize(graph.n);
+        } else {
+            predecessors.clear();
+        }
+        solve<Policy>(graph, source, distances.data(), predecessors.data());
+    }
+
+    // Solve into caller-provided spans of at least graph.n entries each.
+    // predecessors is not touched (and may be null) unless the policy tracks them.
+    template <typename Policy = DefaultPolicy, typename GraphT>
+    static void solve(const GraphT& graph, int source,
+                      double* distances, int* predecessors) {
+        NullVisitor visitor;
+        solve<Policy>(graph, source, distances, predecessors, visitor);
+    }
+
+    template <typename Policy = DefaultPolicy, typename GraphT, typename Visitor>
+    static void solve(const GraphT& graph, int source,
+                      double* distances, int* predecessors, Visitor& visitor) {
+        using Hooks = VisitorTraits<Visitor>;
+        SSSP_TRACE_SCOPE("SimpleDijkstra::solve", "dijkstra", "source", source, "n", graph.n);
+        SSSP_MEMORY_SCOPE(Workspace);
+        using Dist = policy_distance_t<Policy>;
+        int n = graph.n;
+        std::fill(distances, distances + n, INF);
+        if constexpr (Policy::track_predecessors) {
+            std::fill(predecessors, predecessors + n, -1);
+        }
 
         // Priority queue: (distance, vertex)
-        using PQEntry = std::pair<double, int>;
+        using PQEntry = std::pair<Dist, int>;
         std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> pq;
 
-        result.distances[source] = 0.0;
+        distances[source] = 0.0;
         pq.push({0.0, source});
+        if constexpr (Hooks::discover) {
+            if (visitor.discover(source, 0.0) != VisitAction::Continue) {
+                // Nothing else can be reached without the source
+                pq.pop();
+            }
+        }
 
         while (!pq.empty()) {
             auto [dist, u] = pq.top();
             pq.pop();
 
-            if (dist > result.distances[u]) {
+            if (dist > distances[u]) {
                 continue;  // Outdated entry
             }
 
-            for (const auto& [v, w] : graph.adj[u]) {
-                double new_dist = result.distances[u] + w;
-                if (new_dist < result.distances[v]) {
-                    result.distances[v] = new_dist;
-                    result.predecessors[v] = u;
+            if constexpr (Hooks::settle) {
+                VisitAction action = visitor.settle(u, distances[u]);
+                if (action == VisitAction::Stop) break;
+                if (action == VisitAction::Prune) continue;
+            }
+
+            [[maybe_unused]] bool stop = false;
+            for (const auto& [v, w] : graph.outEdges(u)) {
+                Dist new_dist = Dist(distances[u]) + w;
+                if (new_dist < distances[v]) {
+                    if constexpr (Hooks::relax) {
+                        VisitAction action = visitor.relax(u, v, w, static_cast<double>(new_dist));
+                        if (action == VisitAction::Stop) { stop = true; break; }
+                        if (action == VisitAction::Prune) continue;
+                    }
+                    if constexpr (Hooks::discover) {
+                        if (distances[v] == INF) {
+                            VisitAction action = visitor.discover(v, static_cast<double>(new_dist));
+                            if (action == VisitAction::Stop) { stop = true; break; }
+                            if (action == VisitAction::Prune) continue;
+                        }
+                    }
+                    distances[v] = static_cast<double>(new_dist);
+                    if constexpr (Policy::track_predecessors) {
+                        predecessors[v] = u;
+                    }
                     pq.push({new_dist, v});
                 }
             }
+            if constexpr (Hooks::can_stop) {
+                if (stop) break;
+            }
         }
 
-        return result;
+        if constexpr (Hooks::finish) {
+            visitor.finish();
+        }
     }
 };
 
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "graph_types.hpp"
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace sssp {
+
+/**
+ * Filtered view of a SimpleGraph: "the graph minus these vertices/edges"
+ * without building a new graph.
+ *
+ * Closed vertices have no out-edges and edges into them are skipped; closed
+ * edges are skipped. Masks are bitsets applied during iteration, so opening
+ * or closing is O(1) per vertex/edge and the base graph is never copied.
+ * Edges are identified either as (u, index in adj[u]) or by a global edge id
+ * in [0, m), numbered in adjacency order.
+ *
+ * Can be passed anywhere a SimpleGraph is accepted by the solvers, e.g.
+ * BasicNewSSSP<DefaultPolicy, FilteredGraph> or SimpleDijkstra::solve(view, s).
+ * The base graph must outlive the view and must not change while it is used.
+ */
+class FilteredGraph {
+public:
+    using Edge = std::pair<int, double>;
+
+    int n;  // number of nodes (same as base)
+    int m;  // number of edges in the base graph
+
+    // Range over the open out-edges of one vertex
+    class EdgeRange {
+    public:
+        class iterator {
+        public:
+            iterator(const Edge* ptr, const Edge* end, size_t id, const FilteredGraph* g)
+                : ptr_(ptr), end_(end), id_(id), g_(g) {
+                skipClosed();
+            }
+
+            const Edge& operator*() const { return *ptr_; }
+            const Edge* operator->() const { return ptr_; }
+
+            iterator& operator++() {
+                ++ptr_;
+                ++id_;
+                skipClosed();
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return ptr_ == other.ptr_; }
+            bool operator!=(const iterator& other) const { return ptr_ != other.ptr_; }
+
+            // Global id of the current edge
+            size_t edgeId() const { return id_; }
+
+        private:
+            void skipClosed() {
+                if (!g_) return;  // Nothing closed: plain adjacency scan
+                while (ptr_ != end_ && !g_->edgeUsable(id_, ptr_->first)) {
+                    ++ptr_;
+                    ++id_;
+                }
+            }
+
+            const Edge* ptr_;
+            const Edge* end_;
+            size_t id_;
+            const FilteredGraph* g_;
+        };
+
+        EdgeRange(const Edge* first, const Edge* last, size_t first_id, const FilteredGraph* g)
+            : first_(first), last_(last), first_id_(first_id), g_(g) {}
+
+        iterator begin() const { return iterator(first_, last_, first_id_, g_); }
+        iterator end() const { return iterator(last_, last_, first_id_ + (last_ - first_), g_); }
+
+    private:
+        const Edge* first_;
+        const Edge* last_;
+        size_t first_id_;
+        const FilteredGraph* g_;
+    };
+
+    explicit FilteredGraph(const SimpleGraph& g)
+        : n(g.n), m(g.m), base(g), edge_offset(g.n + 1, 0),
+          vertex_closed(g.n, false), edge_closed(0) {
+        for (int u = 0; u < n; ++u) {
+            edge_offset[u + 1] = edge_offset[u] + g.adj[u].size();
+        }
+        edge_closed.assign(edge_offset[n], false);
+    }
+
+    const SimpleGraph& baseGraph() const { return base; }
+
+    EdgeRange outEdges(int u) const {
+        const auto& edges = base.adj[u];
+        if (edges.empty() || vertex_closed[u]) {
+            return EdgeRange(nullptr, nullptr, edge_offset[u], nullptr);
+        }
+        const FilteredGraph* filter =
+            (num_closed_vertices == 0 && num_closed_edges == 0) ? nullptr : this;
+        return EdgeRange(edges.data(), edges.data() + edges.size(), edge_offset[u], filter);
+    }
+
+    size_t edgeId(int u, int index) const { return edge_offset[u] + index; }
+
+    // Mask updates - O(1) each
+    void closeVertex(int v) { setVertex(v, true); }
+    void openVertex(int v) { setVertex(v, false); }
+    void closeEdge(int u, int index) { setEdge(edgeId(u, index), true); }
+    void openEdge(int u, int index) { setEdge(edgeId(u, index), false); }
+    void closeEdge(size_t id) { setEdge(id, true); }
+    void openEdge(size_t id) { setEdge(id, false); }
+
+    bool isVertexOpen(int v) const { return !vertex_closed[v]; }
+    bool isEdgeOpen(int u, int index) const { return !edge_closed[edgeId(u, index)]; }
+
+    int closedVertexCount() const { return num_closed_vertices; }
+    int closedEdgeCount() const { return num_closed_edges; }
+
+    // Reopen everything - O(n + m)
+    void reset() {
+        vertex_closed.assign(n, false);
+        edge_closed.assign(edge_closed.size(), false);
+        num_closed_vertices = 0;
+        num_closed_edges = 0;
+    }
+
+    // Copy of the visible subgraph (for tools that need a SimpleGraph)
+    SimpleGraph materialize() const {
+        SimpleGraph g(n);
+        for (int u = 0; u < n; ++u) {
+            for (const auto& [v, w] : outEdges(u)) {
+                g.add_edge(u, v, w);
+            }
+        }
+        return g;
+    }
+
+private:
+    bool edgeUsable(size_t id, int target) const {
+        return !edge_closed[id] && !vertex_closed[target];
+    }
+
+    void setVertex(int v, bool closed) {
+        if (vertex_closed[v] != closed) {
+            vertex_closed[v] = closed;
+            num_closed_vertices += closed ? 1 : -1;
+        }
+    }
+
+    void setEdge(size_t id, bool closed) {
+        if (edge_closed[id] != closed) {
+            edge_closed[id] = closed;
+            num_closed_edges += closed ? 1 : -1;
+        }
+    }
+
+    const SimpleGraph& base;
+    std::vector<size_t> edge_offset;  // First edge id of each vertex
+    std::vector<bool> vertex_closed;
+    std::vector<bool> edge_closed;
+    int num_closed_vertices = 0;
+    int num_closed_edges = 0;
+};
+
+}  // namespace sssp
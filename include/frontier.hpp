@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace sssp {
+
+/**
+ * Vertex set over [0, n) for the Bellman-Ford rounds of findPivots.
+ *
+ * Membership is a bitmap, and the members are also appended to a list as
+ * they are inserted. Iteration picks one of two representations, as in
+ * direction-optimizing BFS:
+ *
+ * - sparse: the list is sorted and walked, O(s log s) for s members
+ * - dense:  the bitmap is swept word by word, O(n / 64 + s)
+ *
+ * The dense sweep is used once s * dense_ratio >= n. Both visit members in
+ * ascending order, the same order as the std::set it replaces, so results do
+ * not depend on which one was chosen.
+ *
+ * clear() touches only the words that hold members (or the whole bitmap when
+ * that is cheaper), so one Frontier can be reused across many small rounds
+ * without paying O(n) each time.
+ */
+class Frontier {
+public:
+    // Sweep the bitmap once the frontier holds at least n / dense_ratio vertices
+    static constexpr size_t dense_ratio = 1024;
+
+    Frontier() = default;
+    explicit Frontier(int n) { reset(n); }
+
+    // Resize to n vertices and empty - O(n / 64)
+    void reset(int n) {
+        n_ = n;
+        bits_.assign((static_cast<size_t>(n) + 63) / 64, 0);
+        members_.clear();
+    }
+
+    // Returns true if v was not already a member
+    bool insert(int v) {
+        uint64_t& word = bits_[static_cast<size_t>(v) >> 6];
+        uint64_t mask = uint64_t(1) << (v & 63);
+        if (word & mask) return false;
+        word |= mask;
+        members_.push_back(v);
+        return true;
+    }
+
+    bool contains(int v) const {
+        return (bits_[static_cast<size_t>(v) >> 6] >> (v & 63)) & 1;
+    }
+
+    size_t size() const { return members_.size(); }
+    bool empty() const { return members_.empty(); }
+
+    bool isDense() const { return members_.size() * dense_ratio >= static_cast<size_t>(n_); }
+
+    void clear() {
+        if (members_.size() * 8 >= bits_.size()) {
+            std::fill(bits_.begin(), bits_.end(), 0);
+        } else {
+            for (int v : members_) {
+                bits_[static_cast<size_t>(v) >> 6] = 0;
+            }
+        }
+        members_.clear();
+    }
+
+    // Calls f(v) for every member in ascending order until f returns false.
+    // Returns false if stopped early. f must not insert into this frontier.
+    template <typename F>
+    bool forEach(F&& f) {
+        if (isDense()) {
+            for (size_t i = 0; i < bits_.size(); ++i) {
+                for (uint64_t word = bits_[i]; word != 0; word &= word - 1) {
+                    if (!f(static_cast<int>(i * 64 + __builtin_ctzll(word)))) return false;
+                }
+            }
+        } else {
+            std::sort(members_.begin(), members_.end());
+            for (int v : members_) {
+                if (!f(v)) return false;
+            }
+        }
+        return true;
+    }
+
+    void swap(Frontier& other) {
+        std::swap(n_, other.n_);
+        bits_.swap(other.bits_);
+        members_.swap(other.members_);
+    }
+
+private:
+    int n_ = 0;
+    std::vector<uint64_t> bits_;
+    std::vector<int> members_;  // Insertion order until a sparse forEach sorts it
+};
+
+}  // namespace sssp
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "graph_types.hpp"
+#include "shortest_path_certificate.hpp"
+#include "benchmark_stats.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Graph500-style SSSP kernel: timed searches from sampled roots, each
+ * validated, summarized in traversed edges per second (TEPS).
+ *
+ * Roots are distinct random vertices with at least one edge other than a
+ * self-loop. Each search is timed on its own, then validated untimed with
+ * verifyShortestPaths. A search traverses the undirected edges of the
+ * root's component: half the arcs out of reached vertices, since rmat()
+ * stores each edge in both directions. As in Graph500, the rates are
+ * combined by their harmonic mean, i.e. total edges over total time when
+ * every search traverses the same component. Only validated searches count.
+ *
+ *     auto graph = GraphGenerator::rmat(20, 16);
+ *     auto roots = sampleGraph500Roots(graph, 64, seed);
+ *     auto kernel = runGraph500Kernel(graph, roots, [&](int root, double* dist, int* pred) {
+ *         SimpleDijkstra::solve(graph, root, dist, pred);
+ *     });
+ *     std::cout << kernel.harmonicMeanTEPS() << " TEPS\n";
+ */
+struct Graph500Search {
+    int root = -1;
+    double seconds = 0;
+    double traversed_edges = 0;
+    bool valid = false;
+
+    double teps() const { return seconds > 0 ? traversed_edges / seconds : 0.0; }
+};
+
+struct Graph500Kernel {
+    std::vector<Graph500Search> searches;
+
+    size_t validated() const {
+        return std::count_if(searches.begin(), searches.end(),
+                             [](const Graph500Search& s) { return s.valid; });
+    }
+
+    // TEPS of the validated searches, in root order
+    std::vector<double> validTEPS() const {
+        std::vector<double> rates;
+        for (const auto& search : searches) {
+            if (search.valid) rates.push_back(search.teps());
+        }
+        return rates;
+    }
+
+    // 0 if no search validated
+    double harmonicMeanTEPS() const {
+        auto rates = validTEPS();
+        double inverse_sum = 0;
+        for (double rate : rates) {
+            if (rate <= 0) return 0.0;
+            inverse_sum += 1.0 / rate;
+        }
+        return rates.empty() ? 0.0 : rates.size() / inverse_sum;
+    }
+
+    // Min, quartiles and max of the validated TEPS
+    BenchmarkStats tepsStats() const { return BenchmarkStats::compute(validTEPS()); }
+};
+
+// Up to `count` distinct roots, uniformly among vertices with an edge to another vertex
+template <typename GraphT>
+std::vector<int> sampleGraph500Roots(const GraphT& graph, int count, uint32_t seed) {
+    std::vector<int> candidates;
+    for (int v = 0; v < graph.n; ++v) {
+        for (const auto& [u, w] : graph.outEdges(v)) {
+            if (u != v) {
+                candidates.push_back(v);
+                break;
+            }
+        }
+    }
+
+    // Partial Fisher-Yates: the first `count` entries are the sample
+    std::mt19937 rng(seed);
+    size_t k = std::min(candidates.size(), static_cast<size_t>(std::max(0, count)));
+    for (size_t i = 0; i < k; ++i) {
+        std::uniform_int_distribution<size_t> pick(i, candidates.size() - 1);
+        std::swap(candidates[i], candidates[pick(rng)]);
+    }
+    candidates.resize(k);
+    return candidates;
+}
+
+// Runs solve(root, distances, predecessors) from every root; the buffers
+// hold graph.n entries and are reused across searches
+template <typename GraphT, typename Solve>
+Graph500Kernel runGraph500Kernel(const GraphT& graph, const std::vector<int>& roots,
+                                 Solve&& solve, int verify_threads = 0) {
+    Graph500Kernel kernel;
+    std::vector<double> distances(graph.n);
+    std::vector<int> predecessors(graph.n);
+
+    for (int root : roots) {
+        Graph500Search search;
+        search.root = root;
+
+        auto start = std::chrono::steady_clock::now();
+        solve(root, distances.data(), predecessors.data());
+        search.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        search.valid = verifyShortestPaths(graph, root, distances.data(), predecessors.data(),
+                                           verify_threads).valid();
+        double arcs = 0;
+        for (int v = 0; v < graph.n; ++v) {
+            if (distances[v] < INF) arcs += static_cast<double>(graph.outEdges(v).size());
+        }
+        search.traversed_edges = arcs / 2;
+        kernel.searches.push_back(search);
+    }
+    return kernel;
+}
+
+}  // namespace sssp
@@ -0,0 +1,392 @@
+#pragma once
+
+#include "graph_types.hpp"
+#include "csr_graph.hpp"
+#include "trace_recorder.hpp"
+#include "memory_tracker.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SSSP_HAS_MMAP 1
+#endif
+
+namespace sssp {
+
+/**
+ * Binary CSR graph files, and an on-disk cache of generated graphs built
+ * on them.
+ *
+ * A file holds a 64-byte header, the n + 1 edge offsets (uint64) and the m
+ * edges laid out as CSRGraph::Edge (int32 target, zero padding, double
+ * weight), in native byte order. MappedGraph maps a file read-only and
+ * serves outEdges() straight from the mapping, so opening a graph costs
+ * milliseconds whatever its size; pages are read on first access.
+ *
+ *     writeGraphFile(graph, "sparse.csr");
+ *     MappedGraph mapped("sparse.csr");            // throws std::runtime_error if invalid
+ *     auto r = SimpleDijkstra::solve(mapped, 0);   // any GraphT-generic solver
+ */
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t edge_bytes;   // sizeof(CSRGraph::Edge), to reject foreign layouts
+    uint64_t n;
+    uint64_t m;
+    uint64_t key_hash;     // FNV-1a of the cache key ("" for plain files)
+    uint8_t reserved[24];
+};
+static_assert(sizeof(GraphFileHeader) == 64, "graph file header must stay 64 bytes");
+
+inline constexpr char graph_file_magic[8] = {'S', 'S', 'S', 'P', 'C', 'S', 'R', '\0'};
+inline constexpr uint32_t graph_file_version = 1;
+
+inline uint64_t graphCacheKeyHash(const std::string& key) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * Streams a graph file vertex by vertex, for graphs too large to hold as
+ * adjacency lists: memory stays at one edge chunk whatever the graph's size.
+ * Offsets and edges go to their own regions of a temporary file, through
+ * two handles; finish() writes the header and renames the file into place,
+ * so readers never see a partial file.
+ *
+ *     GraphFileWriter writer("roads.csr", n);
+ *     for (int u = 0; u < n; ++u) writer.addVertex(edgesOf(u));   // (target, weight) pairs
+ *     writer.finish();
+ */
+class GraphFileWriter {
+public:
+    GraphFileWriter(const std::string& path, int n, const std::string& key = "")
+        : target(path), n(n) {
+#ifdef SSSP_HAS_MMAP
+        temporary = path + ".tmp" + std::to_string(::getpid());
+#else
+        temporary = path + ".tmp";
+#endif
+        std::memcpy(header.magic, graph_file_magic, sizeof(header.magic));
+        header.version = graph_file_version;
+        header.edge_bytes = sizeof(CSRGraph::Edge);
+        header.n = static_cast<uint64_t>(n);
+        header.key_hash = graphCacheKeyHash(key);
+
+        offsets_out.open(temporary, std::ios::binary | std::ios::trunc);
+        if (!offsets_out) throw std::runtime_error("Cannot write graph file: " + temporary);
+        offsets_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t zero = 0;
+        offsets_out.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+
+        edges_out.open(temporary, std::ios::binary | std::ios::in | std::ios::out);
+        if (!edges_out) throw std::runtime_error("Cannot write graph file: " + temporary);
+        edges_out.seekp(static_cast<std::streamoff>(sizeof(GraphFileHeader) +
+                                                    (header.n + 1) * sizeof(uint64_t)));
+        buffer.reserve(chunk);
+    }
+
+    // Removes the temporary file unless finish() succeeded
+    ~GraphFileWriter() {
+        if (finished) return;
+        offsets_out.close();
+        edges_out.close();
+        std::error_code error;
+        std::filesystem::remove(temporary, error);
+    }
+
+    GraphFileWriter(const GraphFileWriter&) = delete;
+    GraphFileWriter& operator=(const GraphFileWriter&) = delete;
+
+    // Out-edges of the next vertex, as (target, weight) pairs
+    template <typename Edges>
+    void addVertex(const Edges& edges) {
+        if (added == n) throw std::runtime_error("Too many vertices for graph file: " + temporary);
+        for (const auto& [v, w] : edges) {
+            // Padding zeroed, so files are reproducible
+            CSRGraph::Edge edge;
+            std::memset(static_cast<void*>(&edge), 0, sizeof(edge));
+            edge.first = v;
+            edge.second = w;
+            buffer.push_back(edge);
+            if (buffer.size() == chunk) flush();
+            header.m++;
+        }
+        offsets_out.write(reinterpret_cast<const char*>(&header.m), sizeof(header.m));
+        added++;
+    }
+
+    // Edges added so far
+    uint64_t edges() const { return header.m; }
+
+    // Throws std::runtime_error unless all n vertices were added and written
+    void finish() {
+        if (added != n) {
+            throw std::runtime_error("Graph file " + target + " got " + std::to_string(added) +
+                                     " of " + std::to_string(n) + " vertices");
+        }
+        flush();
+        offsets_out.seekp(0);
+        offsets_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        offsets_out.close();
+        edges_out.close();
+        if (!offsets_out || !edges_out) {
+            throw std::runtime_error("Failed writing graph file: " + temporary);
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, target, error);
+        if (error) throw std::runtime_error("Cannot move graph file into place: " + target);
+        finished = true;
+    }
+
+private:
+    static constexpr size_t chunk = 1 << 16;
+
+    void flush() {
+        edges_out.write(reinterpret_cast<const char*>(buffer.data()),
+                        static_cast<std::streamsize>(buffer.size() * sizeof(CSRGraph::Edge)));
+        buffer.clear();
+    }
+
+    std::string target;
+    std::string temporary;
+    int n;
+    int added = 0;
+    bool finished = false;
+    GraphFileHeader header = {};
+    std::ofstream offsets_out;
+    std::fstream edges_out;
+    std::vector<CSRGraph::Edge> buffer;
+};
+
+// Writes g to `path` through a temporary file and a rename, so readers never
+// see a partial file
+inline void writeGraphFile(const SimpleGraph& g, const std::string& path,
+                           const std::string& key = "") {
+    SSSP_TRACE_SCOPE("writeGraphFile", "loader", "n", g.n);
+    GraphFileWriter writer(path, g.n, key);
+    for (int u = 0; u < g.n; ++u) writer.addVertex(g.adj[u]);
+    writer.finish();
+}
+
+/**
+ * Read-only graph over a mapped graph file. Exposes n, m and outEdges(u)
+ * like CSRGraph, so every GraphT-generic solver runs on it directly.
+ * Without mmap (non-POSIX), the file is read into memory instead.
+ */
+class MappedGraph {
+public:
+    using Edge = CSRGraph::Edge;
+    using EdgeSpan = CSRGraph::EdgeSpan;
+
+    int n = 0;
+    int m = 0;
+
+    // Opens `path`; throws std::runtime_error if it is missing, truncated or not a
+    // graph file of this version. A non-empty `key` must match the one it was written with.
+    explicit MappedGraph(const std::string& path, const std::string& key = "") {
+        SSSP_TRACE_SCOPE("MappedGraph::open", "loader");
+        map(path);
+        try {
+            readHeader(path, key);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    ~MappedGraph() { unmap(); }
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    EdgeSpan outEdges(int u) const { return {edges + offsets[u], edges + offsets[u + 1]}; }
+
+    int outDegree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+
+    // Size of the mapped file in bytes
+    size_t bytes() const { return size; }
+
+    // Copy into adjacency lists, for code that needs a SimpleGraph
+    SimpleGraph toSimpleGraph() const {
+        SSSP_TRACE_SCOPE("MappedGraph::toSimpleGraph", "loader", "n", n);
+        SSSP_MEMORY_SCOPE(Graph);
+        SimpleGraph g(n);
+        g.m = m;
+        for (int u = 0; u < n; ++u) {
+            EdgeSpan span = outEdges(u);
+            g.adj[u].assign(span.begin(), span.end());
+        }
+        return g;
+    }
+
+private:
+    void readHeader(const std::string& path, const std::string& key) {
+        if (size < sizeof(GraphFileHeader)) fail(path, "too small for a header");
+
+        GraphFileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, graph_file_magic, sizeof(header.magic)) != 0) {
+            fail(path, "not a graph file");
+        }
+        if (header.version != graph_file_version || header.edge_bytes != sizeof(Edge)) {
+            fail(path, "written by an incompatible version");
+        }
+        if (!key.empty() && header.key_hash != graphCacheKeyHash(key)) {
+            fail(path, "written for another key");
+        }
+        size_t expected = sizeof(GraphFileHeader) + (header.n + 1) * sizeof(uint64_t) +
+                          header.m * sizeof(Edge);
+        if (size != expected) fail(path, "truncated");
+
+        n = static_cast<int>(header.n);
+        m = static_cast<int>(header.m);
+        offsets = reinterpret_cast<const uint64_t*>(data + sizeof(GraphFileHeader));
+        edges = reinterpret_cast<const Edge*>(data + sizeof(GraphFileHeader) +
+                                              (header.n + 1) * sizeof(uint64_t));
+    }
+
+    [[noreturn]] static void fail(const std::string& path, const std::string& reason) {
+        throw std::runtime_error("Invalid graph file " + path + ": " + reason);
+    }
+
+    void map(const std::string& path) {
+#ifdef SSSP_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open graph file: " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat graph file: " + path);
+        }
+        size = static_cast<size_t>(info.st_size);
+        void* mapping = size > 0 ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+        ::close(fd);
+        if (mapping == MAP_FAILED) throw std::runtime_error("Cannot map graph file: " + path);
+        data = static_cast<const char*>(mapping);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("Cannot open graph file: " + path);
+        size = static_cast<size_t>(in.tellg());
+        copy.resize(size / sizeof(uint64_t) + 1);
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(copy.data()), static_cast<std::streamsize>(size));
+        data = reinterpret_cast<const char*>(copy.data());
+#endif
+    }
+
+    void unmap() {
+#ifdef SSSP_HAS_MMAP
+        if (data && size > 0) ::munmap(const_cast<char*>(data), size);
+#endif
+        data = nullptr;
+    }
+
+    const char* data = nullptr;
+    size_t size = 0;
+    const uint64_t* offsets = nullptr;
+    const Edge* edges = nullptr;
+#ifndef SSSP_HAS_MMAP
+    std::vector<uint64_t> copy;  // 8-byte aligned backing store
+#endif
+};
+
+/**
+ * Generated graphs persisted across processes. A key names the generator,
+ * its parameters and seed (and GraphGenerator::version, so stale files are
+ * not reused after a generator changes); the first request for a key runs
+ * the generator and writes the file, later ones, in this or any later
+ * process, map it.
+ *
+ *     GraphCache cache;   // $SSSP_GRAPH_CACHE, else <temp dir>/sssp_graph_cache
+ *     const MappedGraph& g = cache.get("randomSparse_n1000000_m3000000_s47",
+ *         [] { return GraphGenerator::randomSparse(1000000, 3000000, 1.0, 100.0, 47); });
+ *
+ * Graphs stay mapped for the lifetime of the cache. Unreadable or stale
+ * files are regenerated; a directory that cannot be written throws
+ * std::runtime_error. Keys must be usable as file names.
+ */
+class GraphCache {
+public:
+    explicit GraphCache(std::string directory = defaultDirectory())
+        : dir(std::move(directory)) {}
+
+    static std::string defaultDirectory() {
+        if (const char* env = std::getenv("SSSP_GRAPH_CACHE")) {
+            if (*env) return env;
+        }
+        std::error_code error;
+        auto temp = std::filesystem::temp_directory_path(error);
+        return ((error ? std::filesystem::path(".") : temp) / "sssp_graph_cache").string();
+    }
+
+    const std::string& directory() const { return dir; }
+
+    std::string path(const std::string& key) const {
+        return (std::filesystem::path(dir) / (key + ".csr")).string();
+    }
+
+    template <typename Generate>
+    const MappedGraph& get(const std::string& key, Generate&& generate) {
+        return getWritten(key, [&](const std::string& file) {
+            writeGraphFile(generate(), file, key);
+        });
+    }
+
+    // As get(), for generators that write the file themselves: write(path)
+    // streams it, e.g. with a GraphFileWriter for the key
+    template <typename Write>
+    const MappedGraph& getWritten(const std::string& key, Write&& write) {
+        auto it = graphs.find(key);
+        if (it != graphs.end()) return *it->second;
+
+        std::string file = path(key);
+        if (auto mapped = tryOpen(file, key)) {
+            hits++;
+            return *(graphs[key] = std::move(mapped));
+        }
+
+        misses++;
+        std::error_code error;
+        std::filesystem::create_directories(dir, error);
+        write(file);
+        return *(graphs[key] = std::make_unique<MappedGraph>(file, key));
+    }
+
+    // Requests served from disk / generated, since construction
+    size_t diskHits() const { return hits; }
+    size_t generated() const { return misses; }
+
+private:
+    static std::unique_ptr<MappedGraph> tryOpen(const std::string& file, const std::string& key) {
+        std::error_code error;
+        if (!std::filesystem::exists(file, error)) return nullptr;
+        try {
+            return std::make_unique<MappedGraph>(file, key);
+        } catch (const std::runtime_error&) {
+            return nullptr;
+        }
+    }
+
+    std::string dir;
+    std::map<std::string, std::unique_ptr<MappedGraph>> graphs;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+}  // namespace sssp
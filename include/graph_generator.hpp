@@ -1,55 +1,79 @@
 #pragma once
 
 #include "graph_types.hpp"
+#include "parallel_ranges.hpp"
 #include <random>
-#include <set>
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
 
 namespace sssp {
 
 /**
  * Graph generators for testing and benchmarking
+ *
+ * randomSparse, scaleFree and rmat draw their edges in chunks of 2^16, each with
+ * its own generator seeded from (seed, stream, chunk), and fill the chunks
+ * on `num_threads` threads (0 = one per hardware thread). Chunks are added
+ * to the graph in order, so the output depends only on the arguments, not
+ * on the thread count.
  */
 class GraphGenerator {
 public:
-    // Random sparse graph (Erdos-Renyi-like)
-    static SimpleGraph randomSparse(int n, int m, double min_weight = 1.0,
-                                    double max_weight = 100.0, unsigned seed = 42) {
-        std::mt19937 rng(seed);
-        std::uniform_int_distribution<int> node_dist(0, n - 1);
-        std::uniform_real_distribution<double> weight_dist(min_weight, max_weight);
+    // Bumped whenever a generator's output for the same arguments changes;
+    // part of every GraphCache key, so cached graphs are not reused stale
+    static constexpr int version = 2;
 
+    // Random sparse graph (Erdos-Renyi-like): a random spanning tree, then
+    // uniform random edges up to m in total, without self-loops or duplicates.
+    // Duplicates are removed per source vertex after each batch and redrawn,
+    // so no global edge set is needed.
+    static SimpleGraph randomSparse(int n, int m, double min_weight = 1.0,
+                                    double max_weight = 100.0, unsigned seed = 42,
+                                    int num_threads = 0) {
         SimpleGraph g(n);
-        std::set<std::pair<int, int>> edges;
+        if (n <= 0) return g;
 
-        // Ensure connectivity: create a spanning tree first
+        // Ensure connectivity: a spanning tree over a random permutation
+        std::mt19937 rng(seed);
         std::vector<int> perm(n);
         std::iota(perm.begin(), perm.end(), 0);
         std::shuffle(perm.begin(), perm.end(), rng);
 
-        for (int i = 1; i < n; ++i) {
-            std::uniform_int_distribution<int> parent_dist(0, i - 1);
-            int parent = perm[parent_dist(rng)];
-            int child = perm[i];
+        std::vector<uint8_t> touched(n, 0);
+        auto add = [&](const GeneratedEdge& e) { g.adj[e.u].emplace_back(e.v, e.w); };
+        generateEdges(n - 1, seed, 0, num_threads, [&](int64_t i, std::mt19937& chunk_rng) {
+            std::uniform_int_distribution<int> parent_dist(0, static_cast<int>(i));
+            std::uniform_real_distribution<double> weight_dist(min_weight, max_weight);
+            return GeneratedEdge{perm[parent_dist(chunk_rng)], perm[i + 1], weight_dist(chunk_rng)};
+        }, add);
 
-            g.add_edge(parent, child, weight_dist(rng));
-            edges.insert({parent, child});
-        }
-
-        // Add remaining random edges
-        int remaining = m - (n - 1);
-        int attempts = 0;
-        while (remaining > 0 && attempts < m * 10) {
-            int u = node_dist(rng);
-            int v = node_dist(rng);
-            if (u != v && edges.find({u, v}) == edges.end()) {
-                g.add_edge(u, v, weight_dist(rng));
-                edges.insert({u, v});
-                remaining--;
-            }
-            attempts++;
+        // Add remaining random edges, redrawing the duplicates of each batch.
+        // Attempts are capped at 10m, for graphs too dense to fill.
+        int64_t missing = n > 1 ? std::max<int64_t>(0, static_cast<int64_t>(m) - (n - 1)) : 0;
+        int64_t attempts = static_cast<int64_t>(m) * 10;
+        unsigned stream = 1;
+        while (missing > 0 && attempts > 0) {
+            int64_t batch = std::min(missing, attempts);
+            attempts -= batch;
+            generateEdges(batch, seed, stream++, num_threads, [&](int64_t, std::mt19937& chunk_rng) {
+                std::uniform_int_distribution<int> node_dist(0, n - 1);
+                std::uniform_int_distribution<int> other_dist(0, n - 2);
+                std::uniform_real_distribution<double> weight_dist(min_weight, max_weight);
+                int u = node_dist(chunk_rng);
+                int v = other_dist(chunk_rng);
+                if (v >= u) v++;  // No self-loops
+                return GeneratedEdge{u, v, weight_dist(chunk_rng)};
+            }, [&](const GeneratedEdge& e) {
+                add(e);
+                touched[e.u] = 1;
+            });
+            missing = removeDuplicateEdges(g, touched, num_threads);
         }
 
+        int64_t edges = 0;
+        for (const auto& list : g.adj) edges += static_cast<int64_t>(list.size());
+        g.m = static_cast<int>(edges);
         return g;
     }
 
@@ -113,59 +137,118 @@ public:
         return randomSparse(n, m, min_weight, max_weight, seed);
     }
 
-    // Scale-free graph (Barabasi-Albert model) - common in real networks
+    // Scale-free graph (Barabasi-Albert model) - common in real networks.
+    // Each new node attaches to min(m_edges_per_node, new_node) distinct earlier
+    // nodes, in both directions. Targets are drawn from an array holding every
+    // node once per incident edge, so each draw is degree-proportional and
+    // O(1), and the whole graph takes O(n * m_edges_per_node).
     static SimpleGraph scaleFree(int n, int m0, int m_edges_per_node,
                                  double min_weight = 1.0, double max_weight = 100.0,
-                                 unsigned seed = 42) {
+                                 unsigned seed = 42, int num_threads = 0) {
         std::mt19937 rng(seed);
         std::uniform_real_distribution<double> weight_dist(min_weight, max_weight);
-        std::uniform_real_distribution<double> prob_dist(0.0, 1.0);
 
         SimpleGraph g(n);
+        int initial = std::max(0, std::min(m0, n));
 
         // Start with m0 nodes fully connected
-        for (int u = 0; u < m0 && u < n; ++u) {
-            for (int v = u + 1; v < m0 && v < n; ++v) {
+        for (int u = 0; u < initial; ++u) {
+            for (int v = u + 1; v < initial; ++v) {
                 g.add_edge(u, v, weight_dist(rng));
                 g.add_edge(v, u, weight_dist(rng));
             }
         }
 
-        std::vector<int> degrees(n, 0);
-        for (int i = 0; i < m0; ++i) {
-            degrees[i] = m0 - 1;
+        // Every node once per incident (undirected) edge
+        int per_node = std::max(0, m_edges_per_node);
+        std::vector<int> endpoints;
+        endpoints.reserve(static_cast<size_t>(initial) * std::max(0, initial - 1) +
+                          2 * static_cast<size_t>(n - initial) * per_node);
+        for (int i = 0; i < initial; ++i) {
+            endpoints.insert(endpoints.end(), initial - 1, i);
         }
 
         // Add remaining nodes with preferential attachment
-        for (int new_node = m0; new_node < n; ++new_node) {
-            std::set<int> targets;
-            int total_degree = 0;
-            for (int i = 0; i < new_node; ++i) {
-                total_degree += degrees[i];
-            }
-
-            while (static_cast<int>(targets.size()) < m_edges_per_node &&
-                   static_cast<int>(targets.size()) < new_node) {
-                // Preferential attachment
-                double r = prob_dist(rng) * total_degree;
-                double cumsum = 0;
-                for (int i = 0; i < new_node; ++i) {
-                    cumsum += degrees[i];
-                    if (cumsum >= r) {
-                        targets.insert(i);
-                        break;
-                    }
+        std::vector<std::pair<int, int>> attachments;  // (new node, target), in order
+        attachments.reserve(static_cast<size_t>(n - initial) * per_node);
+        std::vector<int> targets;
+        for (int new_node = initial; new_node < n; ++new_node) {
+            int wanted = std::min(per_node, new_node);
+            targets.clear();
+            while (static_cast<int>(targets.size()) < wanted) {
+                int target;
+                if (endpoints.empty()) {  // No edges yet: uniform
+                    target = std::uniform_int_distribution<int>(0, new_node - 1)(rng);
+                } else {
+                    std::uniform_int_distribution<size_t> pick(0, endpoints.size() - 1);
+                    target = endpoints[pick(rng)];
+                }
+                if (std::find(targets.begin(), targets.end(), target) == targets.end()) {
+                    targets.push_back(target);
                 }
             }
-
             for (int target : targets) {
-                g.add_edge(new_node, target, weight_dist(rng));
-                g.add_edge(target, new_node, weight_dist(rng));
-                degrees[new_node]++;
-                degrees[target]++;
+                attachments.emplace_back(new_node, target);
+                endpoints.push_back(new_node);
+                endpoints.push_back(target);
             }
         }
 
+        // Degrees are known now: size the lists once, then draw the weights
+        // of both directions of every attachment in parallel
+        std::vector<int> degree(n, 0);
+        for (int v : endpoints) degree[v]++;
+        for (int u = 0; u < n; ++u) g.adj[u].reserve(degree[u]);
+
+        generateEdges(2 * static_cast<int64_t>(attachments.size()), seed, 1, num_threads,
+                      [&](int64_t i, std::mt19937& chunk_rng) {
+            std::uniform_real_distribution<double> chunk_weight(min_weight, max_weight);
+            auto [node, target] = attachments[i / 2];
+            return i % 2 == 0 ? GeneratedEdge{node, target, chunk_weight(chunk_rng)}
+                              : GeneratedEdge{target, node, chunk_weight(chunk_rng)};
+        }, [&](const GeneratedEdge& e) { g.add_edge(e.u, e.v, e.w); });
+
+        return g;
+    }
+
+    // R-MAT / Kronecker graph, as in the Graph500 benchmark: 2^scale vertices and
+    // edge_factor * 2^scale undirected edges, each stored in both directions.
+    // Each edge picks one quadrant of the adjacency matrix per level, with
+    // probabilities (a, b, c, d) (normalized to sum to 1), which gives the
+    // skewed, power-law degrees of the Graph500 inputs. Vertex labels are then
+    // randomly permuted so high degree does not correlate with low ids.
+    // Duplicate edges are kept, as in Graph500; self-loops are dropped.
+    static SimpleGraph rmat(int scale, int edge_factor, double a = 0.57, double b = 0.19,
+                            double c = 0.19, double d = 0.05, double min_weight = 0.0,
+                            double max_weight = 1.0, unsigned seed = 42, int num_threads = 0) {
+        int n = 1 << scale;
+        double total = a + b + c + d;
+        double pa = a / total;
+        double pb = (a + b) / total;
+        double pc = (a + b + c) / total;
+
+        std::mt19937 rng(seed);
+        std::vector<int> label(n);
+        std::iota(label.begin(), label.end(), 0);
+        std::shuffle(label.begin(), label.end(), rng);
+
+        SimpleGraph g(n);
+        int64_t edges = static_cast<int64_t>(edge_factor) << scale;
+        generateEdges(edges, seed, 0, num_threads, [&](int64_t, std::mt19937& chunk_rng) {
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            std::uniform_real_distribution<double> weight_dist(min_weight, max_weight);
+            int u = 0, v = 0;
+            for (int level = 0; level < scale; ++level) {
+                double r = unit(chunk_rng);
+                u = 2 * u + (r >= pb);                         // c or d: lower half
+                v = 2 * v + (r >= pa && (r < pb || r >= pc));  // b or d: right half
+            }
+            return GeneratedEdge{label[u], label[v], weight_dist(chunk_rng)};
+        }, [&](const GeneratedEdge& e) {
+            if (e.u == e.v) return;
+            g.add_edge(e.u, e.v, e.w);
+            g.add_edge(e.v, e.u, e.w);
+        });
         return g;
     }
 
@@ -188,6 +271,82 @@ public:
 
         return {g, weights};
     }
+
+private:
+    struct GeneratedEdge {
+        int u;
+        int v;
+        double w;
+    };
+
+    static constexpr int64_t edge_chunk = int64_t(1) << 16;
+
+    // Calls sink(make(i, rng)) for i in [0, count), in order of i. make runs on
+    // the worker threads, a chunk of edge_chunk items at a time, with rng seeded
+    // from (seed, stream, chunk); a few chunks per thread are buffered at once.
+    template <typename Make, typename Sink>
+    static void generateEdges(int64_t count, unsigned seed, unsigned stream, int num_threads,
+                              Make&& make, Sink&& sink) {
+        if (count <= 0) return;
+        int64_t chunks = (count + edge_chunk - 1) / edge_chunk;
+        int threads = num_threads > 0 ? num_threads : detail::hardwareThreads();
+        int64_t wave = 4 * static_cast<int64_t>(threads);
+
+        std::vector<GeneratedEdge> buffer;
+        for (int64_t first = 0; first < chunks; first += wave) {
+            int wave_chunks = static_cast<int>(std::min(wave, chunks - first));
+            int64_t base = first * edge_chunk;
+            buffer.resize(std::min(count, base + wave_chunks * edge_chunk) - base);
+
+            detail::parallelRanges(wave_chunks, std::min(threads, wave_chunks),
+                                   [&](int chunk_begin, int chunk_end, int) {
+                for (int c = chunk_begin; c < chunk_end; ++c) {
+                    uint64_t chunk = static_cast<uint64_t>(first + c);
+                    std::seed_seq seq{seed, stream, static_cast<unsigned>(chunk),
+                                      static_cast<unsigned>(chunk >> 32)};
+                    std::mt19937 chunk_rng(seq);
+                    int64_t begin = static_cast<int64_t>(chunk) * edge_chunk;
+                    int64_t end = std::min(count, begin + edge_chunk);
+                    for (int64_t i = begin; i < end; ++i) buffer[i - base] = make(i, chunk_rng);
+                }
+            });
+            for (const auto& edge : buffer) sink(edge);
+        }
+    }
+
+    // Drops repeated targets from the lists of touched vertices, keeping the
+    // first copy (so earlier edges, e.g. the spanning tree, survive); clears
+    // `touched` and returns the number of edges removed
+    static int64_t removeDuplicateEdges(SimpleGraph& g, std::vector<uint8_t>& touched,
+                                        int num_threads) {
+        int threads = detail::workerCount(g.n, num_threads);
+        std::vector<int64_t> removed(threads, 0);
+        detail::parallelRanges(g.n, threads, [&](int begin, int end, int t) {
+            std::vector<std::pair<int, int>> order;  // (target, position)
+            std::vector<uint8_t> keep;
+            for (int u = begin; u < end; ++u) {
+                if (!touched[u]) continue;
+                touched[u] = 0;
+                auto& list = g.adj[u];
+                order.clear();
+                for (size_t i = 0; i < list.size(); ++i) {
+                    order.emplace_back(list[i].first, static_cast<int>(i));
+                }
+                std::sort(order.begin(), order.end());
+                keep.assign(list.size(), 1);
+                for (size_t i = 1; i < order.size(); ++i) {
+                    if (order[i].first == order[i - 1].first) keep[order[i].second] = 0;
+                }
+                size_t kept = 0;
+                for (size_t i = 0; i < list.size(); ++i) {
+                    if (keep[i]) list[kept++] = list[i];
+                }
+                removed[t] += static_cast<int64_t>(list.size() - kept);
+                list.resize(kept);
+            }
+        });
+        return std::accumulate(removed.begin(), removed.end(), int64_t(0));
+    }
 };
 
 }  // namespace sssp
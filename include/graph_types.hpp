@@ -145,6 +145,12 @@ struct SimpleGraph {
         m++;
     }
 
+    // Out-edges of u as (target, weight) pairs. Solvers iterate graphs only
+    // through n, m and outEdges(), so graph views can stand in for SimpleGraph.
+    const std::vector<std::pair<int, double>>& outEdges(int u) const {
+        return adj[u];
+    }
+
     void clear() {
         n = 0;
         m = 0;
@@ -157,6 +163,12 @@ struct SimpleGraph {
     }
 };
 
+// Graph types whose adjacency lists may be sorted by ascending weight
+// (flagged at runtime by a weight_sorted member). Bounded relax loops can
+// then stop at the first edge that exceeds the bound.
+template <typename GraphT>
+inline constexpr bool supports_weight_cutoff = false;
+
 // Convert LEMON graph to SimpleGraph
 inline SimpleGraph lemonToSimple(const Graph& g, const WeightMap& weights) {
     int n = lemon::countNodes(g);
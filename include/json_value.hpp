@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Parsed JSON document, the reading side of JsonWriter.
+ *
+ * Enough for the tools to load what they wrote (benchmark baselines):
+ * objects, arrays, strings with the escapes JsonWriter emits (plus \uXXXX
+ * below 0x80), numbers, booleans and null. Malformed input throws
+ * std::runtime_error with the byte offset.
+ *
+ *     JsonValue doc = JsonValue::parseFile("baseline.json");
+ *     for (const auto& algo : doc["algorithms"].items()) {
+ *         std::string name = algo["name"].asString();
+ *         ...
+ *     }
+ *
+ * Missing keys and out-of-range indices yield a null value, so lookups
+ * can be chained and checked once with isNull().
+ */
+class JsonValue {
+public:
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    JsonValue() = default;
+
+    static JsonValue parse(const std::string& text) {
+        size_t pos = 0;
+        JsonValue value = parseValue(text, pos);
+        skipWhitespace(text, pos);
+        if (pos != text.size()) fail("trailing characters", pos);
+        return value;
+    }
+
+    static JsonValue parseFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open file: " + path);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return parse(buffer.str());
+    }
+
+    Type type() const { return type_; }
+    bool isNull() const { return type_ == Type::Null; }
+    bool isNumber() const { return type_ == Type::Number; }
+    bool isArray() const { return type_ == Type::Array; }
+    bool isObject() const { return type_ == Type::Object; }
+
+    // Null reads as 0 / false / "" so optional fields need no special case
+    double asNumber() const { return type_ == Type::Number ? number_ : 0.0; }
+    bool asBool() const { return type_ == Type::Bool && bool_; }
+    const std::string& asString() const { return string_; }
+
+    const std::vector<JsonValue>& items() const { return array_; }
+    const std::map<std::string, JsonValue>& members() const { return object_; }
+    size_t size() const { return type_ == Type::Array ? array_.size() : object_.size(); }
+
+    bool contains(const std::string& key) const { return object_.count(key) > 0; }
+
+    const JsonValue& operator[](const std::string& key) const {
+        auto it = object_.find(key);
+        return it != object_.end() ? it->second : null();
+    }
+
+    const JsonValue& operator[](size_t index) const {
+        return index < array_.size() ? array_[index] : null();
+    }
+
+    // Numbers of an array (non-numbers read as 0)
+    std::vector<double> asNumbers() const {
+        std::vector<double> numbers;
+        numbers.reserve(array_.size());
+        for (const auto& item : array_) numbers.push_back(item.asNumber());
+        return numbers;
+    }
+
+private:
+    static const JsonValue& null() {
+        static const JsonValue value;
+        return value;
+    }
+
+    [[noreturn]] static void fail(const std::string& what, size_t pos) {
+        throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos) + ": " + what);
+    }
+
+    static void skipWhitespace(const std::string& text, size_t& pos) {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' ||
+                                     text[pos] == '\r' || text[pos] == '\t')) {
+            ++pos;
+        }
+    }
+
+    static void expect(const std::string& text, size_t& pos, const char* literal) {
+        for (const char* c = literal; *c; ++c, ++pos) {
+            if (pos >= text.size() || text[pos] != *c) fail(std::string("expected ") + literal, pos);
+        }
+    }
+
+    static JsonValue parseValue(const std::string& text, size_t& pos) {
+        skipWhitespace(text, pos);
+        if (pos >= text.size()) fail("unexpected end", pos);
+
+        JsonValue value;
+        char c = text[pos];
+        if (c == '{') {
+            value.type_ = Type::Object;
+            ++pos;
+            skipWhitespace(text, pos);
+            if (pos < text.size() && text[pos] == '}') { ++pos; return value; }
+            for (;;) {
+                skipWhitespace(text, pos);
+                std::string key = parseString(text, pos);
+                skipWhitespace(text, pos);
+                expect(text, pos, ":");
+                value.object_[key] = parseValue(text, pos);
+                skipWhitespace(text, pos);
+                if (pos < text.size() && text[pos] == ',') { ++pos; continue; }
+                expect(text, pos, "}");
+                return value;
+            }
+        }
+        if (c == '[') {
+            value.type_ = Type::Array;
+            ++pos;
+            skipWhitespace(text, pos);
+            if (pos < text.size() && text[pos] == ']') { ++pos; return value; }
+            for (;;) {
+                value.array_.push_back(parseValue(text, pos));
+                skipWhitespace(text, pos);
+                if (pos < text.size() && text[pos] == ',') { ++pos; continue; }
+                expect(text, pos, "]");
+                return value;
+            }
+        }
+        if (c == '"') {
+            value.type_ = Type::String;
+            value.string_ = parseString(text, pos);
+            return value;
+        }
+        if (c == 't') { expect(text, pos, "true"); value.type_ = Type::Bool; value.bool_ = true; return value; }
+        if (c == 'f') { expect(text, pos, "false"); value.type_ = Type::Bool; return value; }
+        if (c == 'n') { expect(text, pos, "null"); return value; }
+
+        const char* start = text.c_str() + pos;
+        char* end = nullptr;
+        value.number_ = std::strtod(start, &end);
+        if (end == start) fail("unexpected character", pos);
+        pos += end - start;
+        value.type_ = Type::Number;
+        return value;
+    }
+
+    static std::string parseString(const std::string& text, size_t& pos) {
+        if (pos >= text.size() || text[pos] != '"') fail("expected string", pos);
+        ++pos;
+        std::string result;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c != '\\') {
+                result += c;
+                continue;
+            }
+            if (pos >= text.size()) break;
+            char escape = text[pos++];
+            switch (escape) {
+                case 'n': result += '\n'; break;
+                case 't': result += '\t'; break;
+                case 'r': result += '\r'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'u': {
+                    if (pos + 4 > text.size()) fail("short \\u escape", pos);
+                    long code = std::strtol(text.substr(pos, 4).c_str(), nullptr, 16);
+                    if (code >= 0x80) fail("non-ASCII \\u escape", pos);
+                    result += static_cast<char>(code);
+                    pos += 4;
+                    break;
+                }
+                default: result += escape; break;  // \" \\ \/
+            }
+        }
+        if (pos >= text.size()) fail("unterminated string", pos);
+        ++pos;
+        return result;
+    }
+
+    Type type_ = Type::Null;
+    bool bool_ = false;
+    double number_ = 0.0;
+    std::string string_;
+    std::vector<JsonValue> array_;
+    std::map<std::string, JsonValue> object_;
+};
+
+}  // namespace sssp
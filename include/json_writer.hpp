@@ -0,0 +1,137 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+
+namespace sssp {
+
+/**
+ * Minimal streaming JSON writer for the command-line tools.
+ *
+ * Commas and nesting are tracked internally; the caller emits keys and
+ * values in order:
+ *
+ *     JsonWriter json(out);
+ *     json.beginObject();
+ *     json.key("n").value(graph.n);
+ *     json.key("levels").beginArray();
+ *     ...
+ *     json.endArray();
+ *     json.endObject();
+ *
+ * Non-finite doubles are written as null.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out) : out(out) {}
+
+    JsonWriter& beginObject() { return open('{'); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray() { return open('['); }
+    JsonWriter& endArray() { return close(']'); }
+
+    JsonWriter& key(const std::string& name) {
+        separate();
+        writeString(name);
+        out << ':';
+        after_key = true;
+        return *this;
+    }
+
+    JsonWriter& value(const std::string& s) {
+        separate();
+        writeString(s);
+        return *this;
+    }
+
+    JsonWriter& value(const char* s) { return value(std::string(s)); }
+
+    JsonWriter& value(bool b) {
+        separate();
+        out << (b ? "true" : "false");
+        return *this;
+    }
+
+    JsonWriter& value(double d) {
+        separate();
+        if (std::isfinite(d)) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.17g", d);
+            out << buffer;
+        } else {
+            out << "null";
+        }
+        return *this;
+    }
+
+    JsonWriter& value(int i) { return integer(i); }
+    JsonWriter& value(long i) { return integer(i); }
+    JsonWriter& value(long long i) { return integer(i); }
+    JsonWriter& value(unsigned i) { return integer(i); }
+    JsonWriter& value(unsigned long i) { return integer(i); }
+    JsonWriter& value(unsigned long long i) { return integer(i); }
+
+private:
+    template <typename T>
+    JsonWriter& integer(T i) {
+        separate();
+        out << i;
+        return *this;
+    }
+
+    JsonWriter& open(char bracket) {
+        separate();
+        out << bracket;
+        first.push_back(true);
+        return *this;
+    }
+
+    JsonWriter& close(char bracket) {
+        first.pop_back();
+        out << bracket;
+        return *this;
+    }
+
+    // Comma before every element except the first of its container
+    void separate() {
+        if (after_key) {
+            after_key = false;
+            return;
+        }
+        if (!first.empty()) {
+            if (!first.back()) out << ',';
+            first.back() = false;
+        }
+    }
+
+    void writeString(const std::string& s) {
+        out << '"';
+        for (char c : s) {
+            switch (c) {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                case '\r': out << "\\r"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                        out << buffer;
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+    std::ostream& out;
+    std::vector<bool> first;  // Per open container: no element written yet
+    bool after_key = false;
+};
+
+}  // namespace sssp
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+namespace sssp {
+
+/**
+ * Work done at one BMSSP recursion level, summed over all calls at that
+ * level (level 0 = base case). Filled when the policy has level_stats set.
+ *
+ * time_ms is inclusive: a level-l call contains its level-(l-1) calls, so
+ * the time spent in level l itself is time_ms(l) - time_ms(l - 1).
+ */
+struct LevelStats {
+    int level = 0;
+    size_t calls = 0;               // BMSSP (or base case) calls
+    size_t pulls = 0;               // D.pull()
+    size_t inserts = 0;             // D.insert()
+    size_t prepended = 0;           // Items passed to D.batchPrepend()
+    size_t u_total = 0;             // Sum of |U| returned
+    size_t u_max = 0;               // Largest |U| returned
+    size_t pivot_rounds = 0;        // Bellman-Ford rounds in findPivots
+    size_t pivots = 0;              // Sum of |P|
+    size_t pivot_early_exits = 0;   // findPivots stopped at |W| > k|S|
+    size_t partial_executions = 0;  // Calls that stopped at the |U| limit with D non-empty
+    size_t relaxations = 0;         // Edge scans done by this level's own loops
+    double time_ms = 0;             // Inclusive wall time
+
+    void addU(size_t size) {
+        u_total += size;
+        u_max = std::max(u_max, size);
+    }
+};
+
+}  // namespace sssp
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace sssp {
+
+/**
+ * Allocation accounting by category, plus peak RSS.
+ *
+ * Counting needs the replacement operator new/delete from
+ * counting_allocator.hpp, included in exactly one translation unit of the
+ * program (the tools and the benchmark binary do this when built with
+ * SSSP_ENABLE_MEMORY_TRACKING). Without it, installed() is false and every
+ * count stays zero.
+ *
+ * Allocations are charged to the calling thread's current category. Solvers
+ * and loaders set it with SSSP_MEMORY_SCOPE(Category), compiled in when
+ * SSSP_ENABLE_MEMORY_TRACKING is defined. A scope only saves and restores a
+ * thread-local byte. A block is credited back to the category it was
+ * allocated under, whatever the category is when it is freed.
+ *
+ * Counting is off until enable(true), so timed runs pay only for the block
+ * header. Measure one run with MemoryRun:
+ *
+ *     MemoryTracker::enable(true);
+ *     MemoryRun run;
+ *     solver.solve(source);
+ *     MemoryUsage usage = run.finish();
+ *     MemoryTracker::enable(false);
+ */
+enum class MemoryCategory : uint8_t { Other, Graph, Workspace, DataStructure, Results, Count };
+
+inline constexpr int num_memory_categories = static_cast<int>(MemoryCategory::Count);
+
+inline const char* memoryCategoryName(MemoryCategory category) {
+    static const char* names[num_memory_categories] = {
+        "other", "graph", "workspace", "D", "results"};
+    return names[static_cast<int>(category)];
+}
+
+// Counts for one category (or the total) over one measured interval
+struct MemoryCounters {
+    size_t allocated_bytes = 0;  // Bytes requested by all allocations
+    size_t allocations = 0;
+    long long live_bytes = 0;    // Change in live bytes (freed minus allocated < 0)
+    size_t peak_live_bytes = 0;  // Highest live bytes above the starting level
+};
+
+struct MemoryUsage {
+    std::array<MemoryCounters, num_memory_categories> categories;
+    MemoryCounters total;
+    size_t peak_rss_bytes = 0;   // Resident set high-water mark
+    bool peak_rss_reset = false; // True if the high-water mark was reset at the start
+
+    const MemoryCounters& operator[](MemoryCategory category) const {
+        return categories[static_cast<int>(category)];
+    }
+};
+
+namespace detail {
+
+// Running counts of one category, updated by the allocator
+struct MemorySlot {
+    std::atomic<size_t> allocated{0};
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> live{0};
+    std::atomic<size_t> peak{0};
+};
+
+}  // namespace detail
+
+class MemoryTracker {
+public:
+    // Set by counting_allocator.hpp during static initialization
+    static bool installed() { return is_installed.load(std::memory_order_relaxed); }
+    static void markInstalled() { is_installed.store(true, std::memory_order_relaxed); }
+
+    static void enable(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    static MemoryCategory current() { return current_category; }
+    static void setCurrent(MemoryCategory category) { current_category = category; }
+
+    // Allocator hooks; category index num_memory_categories is the total
+    static void recordAllocation(MemoryCategory category, size_t bytes) {
+        for (int slot : {static_cast<int>(category), num_memory_categories}) {
+            Slot& s = slots[slot];
+            s.allocated.fetch_add(bytes, std::memory_order_relaxed);
+            s.allocations.fetch_add(1, std::memory_order_relaxed);
+            size_t live = s.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            size_t peak = s.peak.load(std::memory_order_relaxed);
+            while (live > peak &&
+                   !s.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    static void recordFree(MemoryCategory category, size_t bytes) {
+        slots[static_cast<int>(category)].live.fetch_sub(bytes, std::memory_order_relaxed);
+        slots[num_memory_categories].live.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    // Current totals (live and peak are absolute, not relative)
+    static std::array<MemoryCounters, num_memory_categories + 1> counters() {
+        std::array<MemoryCounters, num_memory_categories + 1> result;
+        for (int i = 0; i <= num_memory_categories; ++i) {
+            result[i].allocated_bytes = slots[i].allocated.load(std::memory_order_relaxed);
+            result[i].allocations = slots[i].allocations.load(std::memory_order_relaxed);
+            result[i].live_bytes = static_cast<long long>(slots[i].live.load(std::memory_order_relaxed));
+            result[i].peak_live_bytes = slots[i].peak.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // Lower every peak to the current live level
+    static void resetPeaks() {
+        for (auto& s : slots) {
+            s.peak.store(s.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    // Resident set high-water mark (VmHWM), or 0 if unknown
+    static size_t peakRSSBytes() {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::stoull(line.substr(6)) * 1024;
+            }
+        }
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            return static_cast<size_t>(usage.ru_maxrss) * 1024;
+        }
+#endif
+        return 0;
+    }
+
+    // Reset VmHWM to the current RSS (Linux >= 4.0). Returns false if not possible.
+    static bool resetPeakRSS() {
+#ifdef __linux__
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        if (!clear_refs) return false;
+        clear_refs << "5";
+        clear_refs.flush();
+        return static_cast<bool>(clear_refs);
+#else
+        return false;
+#endif
+    }
+
+private:
+    using Slot = detail::MemorySlot;
+
+    static inline std::array<Slot, num_memory_categories + 1> slots;
+    static inline std::atomic<bool> is_installed{false};
+    static inline std::atomic<bool> enabled{false};
+    static inline thread_local MemoryCategory current_category = MemoryCategory::Other;
+};
+
+/**
+ * Usage between construction and finish(): bytes and allocations made,
+ * change in live bytes and peak live bytes above the starting level, per
+ * category and in total, plus peak RSS. Peaks are reset at construction,
+ * so runs must not overlap.
+ */
+class MemoryRun {
+public:
+    MemoryRun() {
+        rss_reset = MemoryTracker::resetPeakRSS();
+        MemoryTracker::resetPeaks();
+        before = MemoryTracker::counters();
+    }
+
+    MemoryUsage finish() const {
+        auto after = MemoryTracker::counters();
+        MemoryUsage usage;
+        for (int i = 0; i <= num_memory_categories; ++i) {
+            MemoryCounters& c = i < num_memory_categories ? usage.categories[i] : usage.total;
+            c.allocated_bytes = after[i].allocated_bytes - before[i].allocated_bytes;
+            c.allocations = after[i].allocations - before[i].allocations;
+            c.live_bytes = after[i].live_bytes - before[i].live_bytes;
+            long long above = static_cast<long long>(after[i].peak_live_bytes) - before[i].live_bytes;
+            c.peak_live_bytes = above > 0 ? static_cast<size_t>(above) : 0;
+        }
+        usage.peak_rss_bytes = MemoryTracker::peakRSSBytes();
+        usage.peak_rss_reset = rss_reset;
+        return usage;
+    }
+
+private:
+    std::array<MemoryCounters, num_memory_categories + 1> before;
+    bool rss_reset = false;
+};
+
+/**
+ * Charges allocations of the calling thread to `category` until destroyed.
+ */
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryCategory category) : saved(MemoryTracker::current()) {
+        MemoryTracker::setCurrent(category);
+    }
+    ~MemoryScope() { MemoryTracker::setCurrent(saved); }
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    MemoryCategory saved;
+};
+
+}  // namespace sssp
+
+#define SSSP_MEMORY_CONCAT_INNER(a, b) a##b
+#define SSSP_MEMORY_CONCAT(a, b) SSSP_MEMORY_CONCAT_INNER(a, b)
+
+#ifdef SSSP_ENABLE_MEMORY_TRACKING
+#define SSSP_MEMORY_SCOPE(category)                                          \
+    ::sssp::MemoryScope SSSP_MEMORY_CONCAT(sssp_memory_scope_, __LINE__)( \
+        ::sssp::MemoryCategory::category)
+#else
+#define SSSP_MEMORY_SCOPE(category) static_cast<void>(0)
+#endif
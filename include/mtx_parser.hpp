@@ -1,6 +1,8 @@
 #pragma once
 
 #include "graph_types.hpp"
+#include "trace_recorder.hpp"
+#include "memory_tracker.hpp"
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -29,6 +31,8 @@ public:
     };
 
     static std::pair<SimpleGraph, GraphInfo> parse(const std::string& filepath) {
+        SSSP_TRACE_SCOPE("MTXParser::parse", "loader");
+        SSSP_MEMORY_SCOPE(Graph);
         std::ifstream file(filepath);
         if (!file.is_open()) {
             throw std::runtime_error("Cannot open file: " + filepath);
@@ -85,6 +89,7 @@ public:
         SimpleGraph graph(info.num_nodes);
 
         // Read edges
+        SSSP_TRACE_SCOPE("MTXParser::readEdges", "loader", "entries", entries);
         int edges_read = 0;
         while (std::getline(file, line)) {
             if (line.empty() || line[0] == '%') {
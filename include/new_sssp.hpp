@@ -2,6 +2,12 @@
 
 #include "graph_types.hpp"
 #include "block_data_structure.hpp"
+#include "solver_policy.hpp"
+#include "solver_visitor.hpp"
+#include "frontier.hpp"
+#include "level_stats.hpp"
+#include "trace_recorder.hpp"
+#include "memory_tracker.hpp"
 #include <vector>
 #include <queue>
 #include <set>
@@ -9,15 +15,68 @@
 #include <cmath>
 #include <algorithm>
 #include <functional>
+#include <type_traits>
+#include <chrono>
 
 namespace sssp {
 
+namespace detail {
+
+// D types may expose a Stats struct (with +=) through stats(); the solver
+// sums it over all BMSSP calls when counting operations.
+struct NoDataStructureStats {};
+
+template <typename D, typename = void>
+struct data_structure_stats {
+    using type = NoDataStructureStats;
+    static constexpr bool available = false;
+};
+
+template <typename D>
+struct data_structure_stats<D, std::void_t<typename D::Stats>> {
+    using type = typename D::Stats;
+    static constexpr bool available = true;
+};
+
+// D types with a `template <int M> using Fixed` member provide variants
+// with a compile-time block size, used by BMSSP for small M
+template <typename D, typename = void>
+constexpr bool has_fixed_block_sizes = false;
+
+template <typename D>
+constexpr bool has_fixed_block_sizes<D, std::void_t<typename D::template Fixed<1>>> = true;
+
+}  // namespace detail
+
 /**
  * Implementation of the O(m log^{2/3} n) SSSP algorithm from
  * "Breaking the Sorting Barrier for Directed Single-Source Shortest Paths"
  * by Duan, Mao, Mao, Shu, and Yin (2025)
+ *
+ * Policy (see solver_policy.hpp) selects predecessor tracking, relaxation
+ * counting and call tracing at compile time. NewSSSP is the default,
+ * fully tracked configuration. The visitor overloads of solve() report
+ * discover/relax/settle events and can prune or stop the search
+ * (solver_visitor.hpp). A vertex is settled once its distance is final:
+ * when the base case extracts it, when a completed BMSSP call returns it in
+ * U, or, for reached vertices neither covered, when the search ends.
+ * findPivots marks W complete after only k relaxation rounds, so it settles
+ * nothing. A settle Prune only stops expansion at the source and at base-case
+ * extractions: vertices of U and those settled at the end were expanded
+ * before their settle, whether by findPivots or by a deeper call.
+ *
+ * GraphT is any graph exposing n, m and outEdges(u) over (target, weight)
+ * pairs: SimpleGraph, or a view such as FilteredGraph. On a weight-sorted
+ * CSRGraph the bounded relax loops stop at the first edge past the bound.
+ *
+ * DataStructure is the D of each BMSSP call: BlockDataStructure (Lemma 3.3),
+ * or an alternative from pull_data_structures.hpp with the same interface.
+ * By default D holds the policy's distance type, so a counting policy
+ * (operation_counts.hpp) also counts the comparisons made inside D.
  */
-class NewSSSP {
+template <typename Policy = DefaultPolicy, typename GraphT = SimpleGraph,
+          typename DataStructure = BasicBlockDataStructure<policy_distance_t<Policy>>>
+class BasicNewSSSP {
 public:
     // Result structure
     struct Result {
@@ -26,22 +85,48 @@ public:
         int source;
     };
 
+    // One entry per BMSSP call, recorded when Policy::trace is set
+    struct CallTrace {
+        int level;
+        double bound;
+        size_t num_sources;
+    };
+
+    // Largest M for which BMSSP uses a compile-time block size variant of D
+    static constexpr int max_fixed_block_size = 128;
+
 private:
-    const SimpleGraph& graph;
+    // Type of distance arithmetic and comparisons; d_hat itself holds doubles
+    using Dist = policy_distance_t<Policy>;
+
+    const GraphT& graph;
     int n, m;
     int k, t;  // Parameters: k = log^{1/3}(n), t = log^{2/3}(n)
     int max_level;
 
-    // Global state
-    std::vector<double> d_hat;     // Distance estimates
-    std::vector<int> pred;         // Predecessors
+    // Global state. d_hat and pred point into the output buffers of the
+    // current solve() call, so results are written in place and never copied.
+    double* d_hat = nullptr;       // Distance estimates
+    int* pred = nullptr;           // Predecessors
     std::vector<bool> complete;    // Whether vertex is complete
+    Frontier pivot_set, frontier, next_frontier;  // findPivots working sets
+    bool weight_sorted = false;    // Adjacency lists sorted by weight (cutoff allowed)
+
+    // Visitor state, only touched when the visitor has the matching hooks
+    std::vector<bool> settled;     // Vertices whose settle hook has run
+    std::vector<bool> pruned;      // Settled vertices whose edges must not be expanded
+    bool stopped = false;
 
     // Statistics
     mutable size_t relaxation_count = 0;
+    std::vector<CallTrace> call_trace;
+    std::vector<LevelStats> level_stats;  // Indexed by level, when Policy::level_stats
+    int stats_level = 0;                  // Level of the BMSSP call currently running
+    using DataStructureStats = typename detail::data_structure_stats<DataStructure>::type;
+    DataStructureStats data_structure_stats;
 
 public:
-    explicit NewSSSP(const SimpleGraph& g)
+    explicit BasicNewSSSP(const GraphT& g)
         : graph(g), n(g.n), m(g.m) {
         // Set parameters
         if (n <= 1) {
@@ -52,73 +137,362 @@ public:
             t = std::max(2, static_cast<int>(std::floor(std::pow(log_n, 2.0/3.0))));
             max_level = std::max(1, static_cast<int>(std::ceil(log_n / t)));
         }
+        if constexpr (supports_weight_cutoff<GraphT>) {
+            weight_sorted = g.weight_sorted;
+        }
     }
 
+    // Solve into a freshly allocated Result. The result vectors are used as
+    // the working buffers directly, so nothing is copied on return.
+    // predecessors stays empty unless the policy tracks them.
     Result solve(int source) {
+        Result result;
+        {
+            SSSP_MEMORY_SCOPE(Results);
+            result.distances.resize(n);
+            if constexpr (Policy::track_predecessors) {
+                result.predecessors.resize(n);
+            }
+        }
+        result.source = source;
+        solve(source, result.distances.data(), result.predecessors.data());
+        return result;
+    }
+
+    template <typename Visitor>
+    Result solve(int source, Visitor& visitor) {
+        Result result;
+        {
+            SSSP_MEMORY_SCOPE(Results);
+            result.distances.resize(n);
+            if constexpr (Policy::track_predecessors) {
+                result.predecessors.resize(n);
+            }
+        }
+        result.source = source;
+        solve(source, result.distances.data(), result.predecessors.data(), visitor);
+        return result;
+    }
+
+    // Solve into caller-owned vectors. They are resized to n; reusing the same
+    // vectors across queries avoids any per-query allocation.
+    void solve(int source, std::vector<double>& distances, std::vector<int>& predecessors) {
+        distances.resize(n);
+        if constexpr (Policy::track_predecessors) {
+            predecessors.resize(n);
+        } else {
+            predecessors.clear();
+        }
+        solve(source, distances.data(), predecessors.data());
+    }
+
+    void solve(int source, std::vector<double>& distances) {
+        static_assert(!Policy::track_predecessors, "policy requires a predecessor buffer");
+        distances.resize(n);
+        solve(source, distances.data(), nullptr);
+    }
+
+    // Solve into caller-provided spans of at least n entries each
+    // (e.g. a row of a distance matrix or a memory-mapped buffer).
+    // predecessors is not touched (and may be null) unless the policy tracks them.
+    void solve(int source, double* distances, int* predecessors) {
+        NullVisitor visitor;
+        solve(source, distances, predecessors, visitor);
+    }
+
+    template <typename Visitor>
+    void solve(int source, double* distances, int* predecessors, Visitor& visitor) {
+        using Hooks = VisitorTraits<Visitor>;
+        SSSP_TRACE_SCOPE("NewSSSP::solve", "sssp", "source", source, "n", n);
+        SSSP_MEMORY_SCOPE(Workspace);
+
         // Initialize
-        d_hat.assign(n, INF);
-        pred.assign(n, -1);
+        d_hat = distances;
+        pred = predecessors;
+        std::fill(d_hat, d_hat + n, INF);
+        if constexpr (Policy::track_predecessors) {
+            std::fill(pred, pred + n, -1);
+        }
         complete.assign(n, false);
+        pivot_set.reset(n);
+        frontier.reset(n);
+        next_frontier.reset(n);
         relaxation_count = 0;
+        call_trace.clear();
+        if constexpr (Policy::level_stats) {
+            level_stats.assign(max_level + 1, LevelStats());
+            for (int level = 0; level <= max_level; ++level) {
+                level_stats[level].level = level;
+            }
+            stats_level = max_level;
+        }
+        data_structure_stats = DataStructureStats();
+        stopped = false;
+        if constexpr (Hooks::settle) {
+            settled.assign(n, false);
+            pruned.assign(n, false);
+        }
 
         d_hat[source] = 0.0;
         complete[source] = true;
+        if constexpr (Hooks::discover) {
+            if (visitor.discover(source, 0.0) == VisitAction::Stop) stopped = true;
+        }
+        visitSettle(visitor, source);
 
         // Relax edges from source
-        for (const auto& [v, w] : graph.adj[source]) {
-            if (d_hat[source] + w < d_hat[v]) {
-                d_hat[v] = d_hat[source] + w;
-                pred[v] = source;
+        if (!stopRequested(visitor) && expandable(visitor, source)) {
+            for (const auto& [v, w] : graph.outEdges(source)) {
+                Dist new_dist = dist(source) + w;
+                if (new_dist < d_hat[v]) {
+                    if (!visitRelax(visitor, source, v, w, new_dist)) {
+                        if (stopRequested(visitor)) break;
+                        continue;
+                    }
+                    d_hat[v] = static_cast<double>(new_dist);
+                    setPred(v, source);
+                }
             }
         }
 
         // Call main algorithm
-        std::set<int> S = {source};
-        auto [B_prime, U] = BMSSP(max_level, INF, S);
+        if (!stopRequested(visitor)) {
+            std::set<int> S = {source};
+            BMSSP(max_level, INF, S, visitor);
+        }
 
-        Result result;
-        result.distances = d_hat;
-        result.predecessors = pred;
-        result.source = source;
-        return result;
+        // Reached vertices no completed call returned are final once the search
+        // is; nothing is expanded after this, so a Prune has no effect
+        if constexpr (Hooks::settle) {
+            for (int v = 0; v < n && !stopRequested(visitor); ++v) {
+                if (d_hat[v] < INF) visitSettle(visitor, v);
+            }
+        }
+
+        if constexpr (Hooks::finish) {
+            visitor.finish();
+        }
+
+        // Do not keep pointers into caller memory past the call
+        d_hat = nullptr;
+        pred = nullptr;
     }
 
+    // Zero unless Policy::count_operations
     size_t getRelaxationCount() const { return relaxation_count; }
 
+    // Empty unless Policy::trace
+    const std::vector<CallTrace>& getCallTrace() const { return call_trace; }
+
+    // One entry per recursion level (0 = base case); empty unless Policy::level_stats
+    const std::vector<LevelStats>& getLevelStats() const { return level_stats; }
+
+    // Algorithm parameters chosen for this graph
+    int getK() const { return k; }
+    int getT() const { return t; }
+    int getMaxLevel() const { return max_level; }
+
+    // Summed D statistics, for D types that report them (e.g. LazyBlockDataStructure).
+    // Zero unless Policy::count_operations
+    const DataStructureStats& getDataStructureStats() const { return data_structure_stats; }
+
 private:
+    Dist dist(int v) const { return Dist(d_hat[v]); }
+
+    void setPred(int v, int u) {
+        if constexpr (Policy::track_predecessors) {
+            pred[v] = u;
+        }
+    }
+
+    void countRelaxation() {
+        if constexpr (Policy::count_operations) {
+            relaxation_count++;
+        }
+        countLevel(&LevelStats::relaxations);
+    }
+
+    // Adds to a counter of the level whose code is running
+    void countLevel(size_t LevelStats::*counter, size_t amount = 1) {
+        if constexpr (Policy::level_stats) {
+            level_stats[stats_level].*counter += amount;
+        }
+    }
+
+    // With weight-sorted adjacency, true once d_hat[u] + w reaches the bound:
+    // every remaining edge of u is at least as heavy, so the scan can stop.
+    // Edges past B are left to the caller's level, which relaxes U again.
+    bool pastBound(Dist new_dist, double B) const {
+        if constexpr (supports_weight_cutoff<GraphT>) {
+            return weight_sorted && new_dist >= B;
+        } else {
+            return false;
+        }
+    }
+
+    // Visitor hooks for an improving relaxation u -> v.
+    // Returns false if the update must be dropped (Prune or Stop).
+    template <typename Visitor>
+    bool visitRelax(Visitor& visitor, int u, int v, double w, Dist new_dist) {
+        using Hooks = VisitorTraits<Visitor>;
+        if constexpr (Hooks::relax) {
+            VisitAction action = visitor.relax(u, v, w, static_cast<double>(new_dist));
+            if (action == VisitAction::Stop) stopped = true;
+            if (action != VisitAction::Continue) return false;
+        }
+        if constexpr (Hooks::discover) {
+            if (d_hat[v] == INF) {
+                VisitAction action = visitor.discover(v, static_cast<double>(new_dist));
+                if (action == VisitAction::Stop) stopped = true;
+                if (action != VisitAction::Continue) return false;
+            }
+        }
+        return true;
+    }
+
+    // Called when u's distance is final; the hook runs once per vertex
+    template <typename Visitor>
+    void visitSettle(Visitor& visitor, int u) {
+        if constexpr (VisitorTraits<Visitor>::settle) {
+            if (settled[u]) return;
+            settled[u] = true;
+            VisitAction action = visitor.settle(u, d_hat[u]);
+            if (action == VisitAction::Stop) {
+                stopped = true;
+            } else if (action == VisitAction::Prune) {
+                pruned[u] = true;
+            }
+        }
+    }
+
+    template <typename Visitor>
+    bool expandable(const Visitor&, int u) const {
+        if constexpr (VisitorTraits<Visitor>::settle) {
+            return !pruned[u];
+        } else {
+            return true;
+        }
+    }
+
+    template <typename Visitor>
+    bool stopRequested(const Visitor&) const {
+        if constexpr (VisitorTraits<Visitor>::can_stop) {
+            return stopped;
+        } else {
+            return false;
+        }
+    }
+
     // Bounded Multi-Source Shortest Path (Algorithm 3)
-    std::pair<double, std::set<int>> BMSSP(int level, double B, const std::set<int>& S) {
+    template <typename Visitor>
+    std::pair<double, std::set<int>> BMSSP(int level, double B, const std::set<int>& S,
+                                           Visitor& visitor) {
+        SSSP_TRACE_SCOPE("BMSSP", "sssp.bmssp", "level", level, "sources", S.size());
+        if constexpr (Policy::trace) {
+            call_trace.push_back({level, B, S.size()});
+        }
+
+        if constexpr (Policy::level_stats) {
+            // Work below is attributed to this level until the call returns
+            int caller_level = stats_level;
+            stats_level = level;
+            auto start = std::chrono::steady_clock::now();
+
+            auto result = runBMSSP(level, B, S, visitor);
+
+            auto& stats = level_stats[level];
+            stats.calls++;
+            stats.addU(result.second.size());
+            stats.time_ms += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            stats_level = caller_level;
+            settleReturned(result.second, visitor);
+            return result;
+        } else {
+            auto result = runBMSSP(level, B, S, visitor);
+            settleReturned(result.second, visitor);
+            return result;
+        }
+    }
+
+    // A completed BMSSP call returns U with final distances. Its vertices were
+    // already expanded, so a Prune here has no effect.
+    template <typename Visitor>
+    void settleReturned(const std::set<int>& U, Visitor& visitor) {
+        if constexpr (VisitorTraits<Visitor>::settle) {
+            for (int u : U) {
+                if (stopRequested(visitor)) return;
+                visitSettle(visitor, u);
+            }
+        }
+    }
+
+    template <typename Visitor>
+    std::pair<double, std::set<int>> runBMSSP(int level, double B, const std::set<int>& S,
+                                              Visitor& visitor) {
         if (level == 0) {
-            return baseCase(B, S);
+            return baseCase(B, S, visitor);
         }
 
         // FindPivots
-        auto [P, W] = findPivots(B, S);
+        auto [P, W] = findPivots(B, S, visitor);
+        countLevel(&LevelStats::pivots, P.size());
 
-        if (P.empty()) {
+        if (P.empty() || stopRequested(visitor)) {
             // All vertices complete
             return {B, W};
         }
 
-        // Initialize data structure D
         int M = static_cast<int>(std::pow(2, (level - 1) * t));
         M = std::max(1, std::min(M, n));
 
-        BlockDataStructure D;
-        D.initialize(M, B, k * static_cast<int>(std::pow(2, level * t)));
+        return BMSSPFixed<1>(level, B, M, P, W, visitor);
+    }
 
-        // Insert pivots into D
-        for (int x : P) {
-            if (d_hat[x] < B) {
-                D.insert(x, d_hat[x]);
+    // Runs the main loop with DataStructure::Fixed<M> if D provides
+    // compile-time block sizes and M is a power of two up to
+    // max_fixed_block_size, and with DataStructure otherwise. Only
+    // LazyBlockDataStructure provides them: the default D keeps its blocks
+    // in std::lists, which a compile-time M would not change.
+    template <int FixedM, typename Visitor>
+    std::pair<double, std::set<int>> BMSSPFixed(int level, double B, int M, const std::set<int>& P,
+                                                const std::set<int>& W, Visitor& visitor) {
+        if constexpr (!detail::has_fixed_block_sizes<DataStructure> ||
+                      FixedM > max_fixed_block_size) {
+            return BMSSPLoop<DataStructure>(level, B, M, P, W, visitor);
+        } else {
+            if (M == FixedM) {
+                return BMSSPLoop<typename DataStructure::template Fixed<FixedM>>(
+                    level, B, M, P, W, visitor);
+            }
+            return BMSSPFixed<FixedM * 2>(level, B, M, P, W, visitor);
+        }
+    }
+
+    // Main loop of BMSSP over pivots P (W from findPivots), with D of type DS
+    template <typename DS, typename Visitor>
+    std::pair<double, std::set<int>> BMSSPLoop(int level, double B, int M, const std::set<int>& P,
+                                               const std::set<int>& W, Visitor& visitor) {
+        // Initialize data structure D
+        DS D;
+        {
+            SSSP_MEMORY_SCOPE(DataStructure);
+            D.initialize(M, B, k * static_cast<int>(std::pow(2, level * t)));
+
+            // Insert pivots into D
+            for (int x : P) {
+                if (dist(x) < B) {
+                    D.insert(x, d_hat[x]);
+                    countLevel(&LevelStats::inserts);
+                }
             }
         }
 
         // Initialize
         double B_prime_0 = INF;
         for (int x : P) {
-            if (complete[x]) {
-                B_prime_0 = std::min(B_prime_0, d_hat[x]);
+            if (complete[x] && dist(x) < B_prime_0) {
+                B_prime_0 = d_hat[x];
             }
         }
         if (B_prime_0 == INF && !P.empty()) {
@@ -133,51 +507,85 @@ private:
         // Main loop
         while (static_cast<int>(U.size()) < size_limit && !D.empty()) {
             // Pull from D
-            auto [Si_vec, Bi] = D.pull();
+            auto [Si_vec, D_bound] = tracedPull(D);
+            double Bi = static_cast<double>(D_bound);
+            countLevel(&LevelStats::pulls);
             std::set<int> Si(Si_vec.begin(), Si_vec.end());
 
             if (Si.empty()) break;
 
             // Recursive call
-            auto [B_prime_i_new, Ui] = BMSSP(level - 1, Bi, Si);
+            auto [B_prime_i_new, Ui] = BMSSP(level - 1, Bi, Si, visitor);
             B_prime_i = B_prime_i_new;
 
             // Add Ui to U
             U.insert(Ui.begin(), Ui.end());
+            if (stopRequested(visitor)) break;
 
             // Relax edges from Ui
-            std::vector<BlockDataStructure::KeyValue> K;
-            for (int u : Ui) {
-                for (const auto& [v, w] : graph.adj[u]) {
-                    relaxation_count++;
-                    if (d_hat[u] + w <= d_hat[v]) {
-                        d_hat[v] = d_hat[u] + w;
-                        pred[v] = u;
-
-                        if (d_hat[u] + w >= Bi && d_hat[u] + w < B) {
-                            D.insert(v, d_hat[u] + w);
-                        } else if (d_hat[u] + w >= B_prime_i && d_hat[u] + w < Bi) {
-                            K.emplace_back(v, d_hat[u] + w);
+            // One memory scope for the whole loop, not one per insert: K, the
+            // batch headed for D, is charged to D along with the inserts
+            std::vector<typename DS::KeyValue> K;
+            {
+                SSSP_TRACE_SCOPE("relax", "sssp.bmssp", "vertices", Ui.size());
+                SSSP_MEMORY_SCOPE(DataStructure);
+                for (int u : Ui) {
+                    if (!expandable(visitor, u)) continue;
+                    for (const auto& [v, w] : graph.outEdges(u)) {
+                        Dist new_dist = dist(u) + w;
+                        if (pastBound(new_dist, B)) break;
+                        countRelaxation();
+                        if (new_dist <= d_hat[v]) {
+                            if (!visitRelax(visitor, u, v, w, new_dist)) {
+                                if (stopRequested(visitor)) break;
+                                continue;
+                            }
+                            d_hat[v] = static_cast<double>(new_dist);
+                            setPred(v, u);
+
+                            if (new_dist >= Bi && new_dist < B) {
+                                D.insert(v, d_hat[v]);
+                                countLevel(&LevelStats::inserts);
+                            } else if (new_dist >= B_prime_i && new_dist < Bi) {
+                                K.emplace_back(v, d_hat[v]);
+                            }
                         }
                     }
+                    if (stopRequested(visitor)) break;
                 }
             }
+            if (stopRequested(visitor)) break;
 
             // BatchPrepend K and vertices from Si that need to go back
             for (int x : Si) {
-                if (d_hat[x] >= B_prime_i && d_hat[x] < Bi) {
+                if (dist(x) >= B_prime_i && dist(x) < Bi) {
                     K.emplace_back(x, d_hat[x]);
                 }
             }
-            D.batchPrepend(K);
+            countLevel(&LevelStats::prepended, K.size());
+            {
+                SSSP_TRACE_SCOPE("batchPrepend", "sssp.D", "items", K.size());
+                SSSP_MEMORY_SCOPE(DataStructure);
+                D.batchPrepend(K);
+            }
+        }
+
+        if (static_cast<int>(U.size()) >= size_limit && !D.empty()) {
+            countLevel(&LevelStats::partial_executions);
+        }
+
+        if constexpr (Policy::count_operations &&
+                      detail::data_structure_stats<DataStructure>::available &&
+                      detail::data_structure_stats<DS>::available) {
+            data_structure_stats += D.stats();
         }
 
         // Final B'
-        double B_prime = std::min(B_prime_i, B);
+        double B_prime = Dist(B_prime_i) < B ? B_prime_i : B;
 
         // Add vertices from W with d_hat < B'
         for (int x : W) {
-            if (d_hat[x] < B_prime) {
+            if (dist(x) < B_prime) {
                 U.insert(x);
             }
         }
@@ -185,8 +593,18 @@ private:
         return {B_prime, U};
     }
 
+    // D.pull(), as its own trace event and charged to the D memory category
+    template <typename DS>
+    static auto tracedPull(DS& D) {
+        SSSP_TRACE_SCOPE("pull", "sssp.D", "size", D.size());
+        SSSP_MEMORY_SCOPE(DataStructure);
+        return D.pull();
+    }
+
     // Base case (Algorithm 2) - mini Dijkstra
-    std::pair<double, std::set<int>> baseCase(double B, const std::set<int>& S) {
+    template <typename Visitor>
+    std::pair<double, std::set<int>> baseCase(double B, const std::set<int>& S, Visitor& visitor) {
+        SSSP_TRACE_SCOPE("baseCase", "sssp.bmssp");
         if (S.empty()) {
             return {B, {}};
         }
@@ -196,7 +614,7 @@ private:
         U0.insert(x);
 
         // Priority queue: (distance, vertex)
-        using PQEntry = std::pair<double, int>;
+        using PQEntry = std::pair<Dist, int>;
         std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> H;
         std::set<int> in_heap;
 
@@ -204,21 +622,30 @@ private:
         in_heap.insert(x);
 
         while (!H.empty() && static_cast<int>(U0.size()) < k + 1) {
-            auto [dist, u] = H.top();
+            auto [entry_dist, u] = H.top();
             H.pop();
 
-            if (dist > d_hat[u]) continue;  // Outdated entry
+            if (entry_dist > d_hat[u]) continue;  // Outdated entry
 
             U0.insert(u);
             complete[u] = true;
+            visitSettle(visitor, u);
+            if (stopRequested(visitor)) break;
+            if (!expandable(visitor, u)) continue;
+
+            for (const auto& [v, w] : graph.outEdges(u)) {
+                Dist new_dist = dist(u) + w;
+                if (pastBound(new_dist, B)) break;
+                countRelaxation();
+                if (new_dist <= d_hat[v] && new_dist < B) {
+                    if (!visitRelax(visitor, u, v, w, new_dist)) {
+                        if (stopRequested(visitor)) break;
+                        continue;
+                    }
+                    d_hat[v] = static_cast<double>(new_dist);
+                    setPred(v, u);
 
-            for (const auto& [v, w] : graph.adj[u]) {
-                relaxation_count++;
-                if (d_hat[u] + w <= d_hat[v] && d_hat[u] + w < B) {
-                    d_hat[v] = d_hat[u] + w;
-                    pred[v] = u;
-
-                    H.push({d_hat[v], v});
+                    H.push({new_dist, v});
                     in_heap.insert(v);
                 }
             }
@@ -228,55 +655,78 @@ private:
             return {B, U0};
         } else {
             // Find max distance and return B' = max distance
-            double max_dist = 0;
+            Dist max_dist = 0.0;
             for (int v : U0) {
-                max_dist = std::max(max_dist, d_hat[v]);
+                max_dist = std::max(max_dist, dist(v));
             }
 
             std::set<int> U_result;
             for (int v : U0) {
-                if (d_hat[v] < max_dist) {
+                if (dist(v) < max_dist) {
                     U_result.insert(v);
                 }
             }
-            return {max_dist, U_result};
+            return {static_cast<double>(max_dist), U_result};
         }
     }
 
     // Find Pivots (Algorithm 1)
-    std::pair<std::set<int>, std::set<int>> findPivots(double B, const std::set<int>& S) {
-        std::set<int> W = S;
-        std::set<int> Wi_prev = S;
+    template <typename Visitor>
+    std::pair<std::set<int>, std::set<int>> findPivots(double B, const std::set<int>& S,
+                                                       Visitor& visitor) {
+        SSSP_TRACE_SCOPE("findPivots", "sssp.bmssp", "sources", S.size());
+        // W and the round frontiers are bitmap-backed and reused across calls
+        Frontier& W = pivot_set;
+        Frontier& Wi_prev = frontier;
+        Frontier& Wi = next_frontier;
+        W.clear();
+        Wi_prev.clear();
+        for (int x : S) {
+            W.insert(x);
+            Wi_prev.insert(x);
+        }
 
         // Relax for k steps
         for (int i = 0; i < k; ++i) {
-            std::set<int> Wi;
-
-            for (int u : Wi_prev) {
-                for (const auto& [v, w] : graph.adj[u]) {
-                    relaxation_count++;
-                    if (d_hat[u] + w <= d_hat[v]) {
-                        d_hat[v] = d_hat[u] + w;
-                        pred[v] = u;
+            Wi.clear();
+            countLevel(&LevelStats::pivot_rounds);
+
+            bool finished = Wi_prev.forEach([&](int u) {
+                if (!expandable(visitor, u)) return true;
+                for (const auto& [v, w] : graph.outEdges(u)) {
+                    Dist new_dist = dist(u) + w;
+                    if (pastBound(new_dist, B)) break;
+                    countRelaxation();
+                    if (new_dist <= d_hat[v]) {
+                        if (!visitRelax(visitor, u, v, w, new_dist)) {
+                            if (stopRequested(visitor)) break;
+                            continue;
+                        }
+                        d_hat[v] = static_cast<double>(new_dist);
+                        setPred(v, u);
 
-                        if (d_hat[u] + w < B) {
+                        if (new_dist < B) {
                             Wi.insert(v);
                         }
                     }
                 }
-            }
+                return !stopRequested(visitor);
+            });
+            if (!finished) return {{}, toSet(W)};
 
-            for (int v : Wi) {
+            Wi.forEach([&](int v) {
                 W.insert(v);
-            }
+                return true;
+            });
 
             // Early termination if W is too large
             if (static_cast<int>(W.size()) > k * static_cast<int>(S.size())) {
                 // Return P = S
-                return {S, W};
+                countLevel(&LevelStats::pivot_early_exits);
+                return {S, toSet(W)};
             }
 
-            Wi_prev = Wi;
+            Wi_prev.swap(Wi);
         }
 
         // Build forest F and find pivots
@@ -285,19 +735,37 @@ private:
         std::map<int, int> parent;
         std::set<int> roots;
 
-        for (int v : W) {
+        W.forEach([&](int v) {
             if (S.count(v)) {
                 roots.insert(v);
             }
-        }
-
-        // Build tree structure based on predecessors
-        for (int v : W) {
-            if (pred[v] >= 0 && W.count(pred[v])) {
-                children[pred[v]].push_back(v);
-                parent[v] = pred[v];
-            } else if (S.count(v)) {
-                // v is a root
+            return true;
+        });
+
+        if constexpr (Policy::track_predecessors) {
+            // Build tree structure based on predecessors
+            W.forEach([&](int v) {
+                if (pred[v] >= 0 && W.contains(pred[v])) {
+                    children[pred[v]].push_back(v);
+                    parent[v] = pred[v];
+                }
+                return true;
+            });
+        } else {
+            // No predecessor array: follow tight edges from the roots instead,
+            // reaching each vertex of W at most once so F stays a forest
+            std::set<int> reached(roots.begin(), roots.end());
+            std::vector<int> stack(roots.begin(), roots.end());
+            while (!stack.empty()) {
+                int u = stack.back();
+                stack.pop_back();
+                for (const auto& [v, w] : graph.outEdges(u)) {
+                    if (W.contains(v) && !reached.count(v) && dist(u) + w == d_hat[v]) {
+                        reached.insert(v);
+                        children[u].push_back(v);
+                        stack.push_back(v);
+                    }
+                }
             }
         }
 
@@ -308,7 +776,7 @@ private:
         std::function<int(int)> computeSize = [&](int v) -> int {
             int size = 1;
             for (int child : children[v]) {
-                if (W.count(child)) {
+                if (W.contains(child)) {
                     size += computeSize(child);
                 }
             }
@@ -334,16 +802,30 @@ private:
         }
 
         // Mark vertices in W as complete if they're fully resolved
-        for (int v : W) {
+        W.forEach([&](int v) {
             // A vertex is complete if we've fully explored its shortest path
-            // For simplicity, mark those that were visited in k steps
+            // For simplicity, mark those that were visited in k steps.
+            // Their distances may still drop, so they are not settled here.
             complete[v] = true;
-        }
+            return true;
+        });
 
-        return {P, W};
+        return {P, toSet(W)};
+    }
+
+    // Members of a frontier as a std::set (built in ascending order, O(s))
+    static std::set<int> toSet(Frontier& f) {
+        std::set<int> result;
+        f.forEach([&](int v) {
+            result.insert(result.end(), v);
+            return true;
+        });
+        return result;
     }
 };
 
+using NewSSSP = BasicNewSSSP<DefaultPolicy>;
+
 // Convenience function
 inline NewSSSP::Result computeNewSSSP(const SimpleGraph& graph, int source) {
     NewSSSP solver(graph);
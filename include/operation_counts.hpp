@@ -0,0 +1,88 @@
+#pragma once
+
+#include "counted_number.hpp"
+#include "new_sssp.hpp"
+#include "dijkstra_lemon.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Operation counts of each solver in the comparison-addition model, the
+ * model the paper's O(m log^{2/3} n) bound is stated in. Unlike wall time,
+ * the counts do not depend on the machine, so their growth over n can be
+ * compared with the bounds below directly.
+ *
+ * The solvers run with CountedDouble as their distance type: every
+ * distance addition and comparison is counted, including those made by
+ * std::priority_queue, by the sorts and sets of BlockDataStructure and by
+ * LEMON's heap. Graph conversion and result extraction are not counted.
+ *
+ *     auto counts = countNewSSSPOperations(graph, 0);
+ *     double ratio = counts.total() / newSSSPBound(graph.n, graph.m);
+ */
+
+// DefaultPolicy with counted distances
+using OperationCountPolicy = SolverPolicy<true, true, false, false, CountedDouble>;
+
+// m log^{2/3} n: the paper's bound for BMSSP
+inline double newSSSPBound(double n, double m) {
+    return m * std::pow(std::log2(std::max(n, 2.0)), 2.0 / 3.0);
+}
+
+// m + n log n: Dijkstra with a Fibonacci heap, the sorting barrier
+inline double sortingBarrierBound(double n, double m) {
+    return m + n * std::log2(std::max(n, 2.0));
+}
+
+// Each function fills `distances` (if given) so counted runs can be checked
+// against an uncounted one
+
+template <typename GraphT>
+OperationCounts countSimpleDijkstraOperations(const GraphT& graph, int source,
+                                              std::vector<double>* distances = nullptr) {
+    std::vector<double> dist;
+    std::vector<int> pred;
+    OperationCounts counts = countOperations([&] {
+        SimpleDijkstra::solve<OperationCountPolicy>(graph, source, dist, pred);
+    });
+    if (distances) *distances = std::move(dist);
+    return counts;
+}
+
+template <typename GraphT>
+OperationCounts countLemonOperations(const GraphT& graph, int source,
+                                     std::vector<double>* distances = nullptr) {
+    using LengthMap = Graph::ArcMap<CountedDouble>;
+    Graph lemon_graph;
+    LengthMap lengths(lemon_graph);
+    std::vector<Node> nodes = DijkstraLemon::buildGraph(graph, lemon_graph, lengths);
+
+    lemon::Dijkstra<Graph, LengthMap> dijkstra(lemon_graph, lengths);
+    OperationCounts counts = countOperations([&] { dijkstra.run(nodes[source]); });
+
+    if (distances) {
+        distances->assign(graph.n, INF);
+        for (int v = 0; v < graph.n; ++v) {
+            if (dijkstra.reached(nodes[v])) {
+                (*distances)[v] = static_cast<double>(dijkstra.dist(nodes[v]));
+            }
+        }
+    }
+    return counts;
+}
+
+template <typename GraphT>
+OperationCounts countNewSSSPOperations(const GraphT& graph, int source,
+                                       std::vector<double>* distances = nullptr) {
+    std::vector<double> dist;
+    std::vector<int> pred;
+    BasicNewSSSP<OperationCountPolicy, GraphT> solver(graph);
+    OperationCounts counts = countOperations([&] { solver.solve(source, dist, pred); });
+    if (distances) *distances = std::move(dist);
+    return counts;
+}
+
+}  // namespace sssp
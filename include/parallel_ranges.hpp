@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace sssp {
+namespace detail {
+
+// One per hardware thread (at least 1)
+inline int hardwareThreads() {
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Threads for a scan over n vertices: `requested`, or one per hardware
+// thread if 0, and no more than one per 1024 vertices
+inline int workerCount(int n, int requested) {
+    int threads = requested > 0 ? requested : hardwareThreads();
+    return std::max(1, std::min(threads, n / 1024 + 1));
+}
+
+// Runs f(begin, end, index) over [0, n) split into `threads` contiguous ranges
+template <typename F>
+void parallelRanges(int n, int threads, F&& f) {
+    if (threads == 1) {
+        f(0, n, 0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) {
+        int begin = static_cast<int>(static_cast<int64_t>(n) * t / threads);
+        int end = static_cast<int>(static_cast<int64_t>(n) * (t + 1) / threads);
+        workers.emplace_back([&f, begin, end, t] { f(begin, end, t); });
+    }
+    for (auto& worker : workers) worker.join();
+}
+
+}  // namespace detail
+}  // namespace sssp
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+namespace sssp {
+
+/**
+ * Lazy path reconstruction from a predecessor array.
+ *
+ * All solvers return a predecessor array (-1 for the source and for
+ * unreachable vertices). These helpers walk it only for the requested
+ * targets, so callers never materialize the full shortest-path tree.
+ */
+
+// Path source -> target as a list of vertices; empty if target is unreachable
+// or the predecessor chain does not lead back to source.
+inline std::vector<int> extractPath(const int* predecessors, int n, int source, int target) {
+    std::vector<int> path;
+    if (target < 0 || target >= n || source < 0 || source >= n) {
+        return path;
+    }
+
+    // A valid chain has at most n vertices; anything longer is a cycle
+    int v = target;
+    while (v != source) {
+        if (v < 0 || static_cast<int>(path.size()) >= n) {
+            return {};
+        }
+        path.push_back(v);
+        v = predecessors[v];
+    }
+    path.push_back(source);
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+inline std::vector<int> extractPath(const std::vector<int>& predecessors, int source, int target) {
+    return extractPath(predecessors.data(), static_cast<int>(predecessors.size()), source, target);
+}
+
+// Paths for several targets, in the order given
+inline std::vector<std::vector<int>> extractPaths(const std::vector<int>& predecessors, int source,
+                                                  const std::vector<int>& targets) {
+    std::vector<std::vector<int>> paths;
+    paths.reserve(targets.size());
+    for (int target : targets) {
+        paths.push_back(extractPath(predecessors, source, target));
+    }
+    return paths;
+}
+
+// Number of edges on the path source -> target, or -1 if there is none.
+// Walks the chain without allocating.
+inline int pathHopCount(const std::vector<int>& predecessors, int source, int target) {
+    int n = static_cast<int>(predecessors.size());
+    if (target < 0 || target >= n || source < 0 || source >= n) {
+        return -1;
+    }
+
+    int hops = 0;
+    for (int v = target; v != source; v = predecessors[v]) {
+        if (v < 0 || hops >= n) {
+            return -1;
+        }
+        hops++;
+    }
+    return hops;
+}
+
+}  // namespace sssp
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace sssp {
+
+/**
+ * Hardware performance counters for the calling thread, via Linux
+ * perf_event_open.
+ *
+ * All events are opened as one group, so they are scheduled onto the PMU
+ * together and describe the same interval. If the kernel multiplexes the
+ * group, counts are scaled by time_enabled / time_running. Kernel and
+ * hypervisor work is excluded, which lets the counters open at the default
+ * perf_event_paranoid level of 2.
+ *
+ * Events the CPU or VM does not support are left out. If cycles cannot be
+ * opened (not Linux, no PMU, or perf_event_paranoid too high), available()
+ * is false and error() says why. start()/stop()/read() are then no-ops, so
+ * callers do not need to branch.
+ *
+ *     PerfCounters counters;
+ *     counters.start();
+ *     solve();
+ *     counters.stop();
+ *     auto sample = counters.read();
+ *     if (sample.has(PerfCounters::Instructions)) ...
+ */
+class PerfCounters {
+public:
+    enum Event { Cycles, Instructions, LLCMisses, BranchMisses, DTLBMisses, NumEvents };
+
+    static const char* name(Event event) {
+        static const char* names[NumEvents] = {
+            "cycles", "instructions", "LLC-misses", "branch-misses", "dTLB-misses"};
+        return names[event];
+    }
+
+    struct Sample {
+        std::array<double, NumEvents> values{};
+        std::array<bool, NumEvents> valid{};
+
+        bool has(Event event) const { return valid[event]; }
+        double operator[](Event event) const { return values[event]; }
+    };
+
+    PerfCounters() {
+        fds.fill(-1);
+#ifdef __linux__
+        for (int e = 0; e < NumEvents; ++e) {
+            open(static_cast<Event>(e));
+            if (e == Cycles && fds[Cycles] < 0) return;  // No group leader
+        }
+#else
+        error_message = "hardware counters need Linux perf_event_open";
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return fds[Cycles] >= 0; }
+    bool has(Event event) const { return fds[event] >= 0; }
+    const std::string& error() const { return error_message; }
+
+    void start() {
+#ifdef __linux__
+        if (!available()) return;
+        ioctl(fds[Cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        if (!available()) return;
+        ioctl(fds[Cycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    // Counts since the last start(), scaled for multiplexing
+    Sample read() const {
+        Sample sample;
+#ifdef __linux__
+        if (!available()) return sample;
+
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then one
+        // value per event in the order the events were opened
+        std::array<uint64_t, 3 + NumEvents> buffer{};
+        ssize_t bytes = ::read(fds[Cycles], buffer.data(), sizeof(buffer));
+        if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t))) return sample;
+
+        uint64_t count = buffer[0];
+        double enabled = static_cast<double>(buffer[1]);
+        double running = static_cast<double>(buffer[2]);
+        double scale = running > 0 ? enabled / running : 0.0;
+
+        size_t slot = 0;
+        for (int e = 0; e < NumEvents && slot < count; ++e) {
+            if (fds[e] < 0) continue;
+            sample.values[e] = static_cast<double>(buffer[3 + slot]) * scale;
+            sample.valid[e] = running > 0;
+            slot++;
+        }
+#endif
+        return sample;
+    }
+
+private:
+#ifdef __linux__
+    void open(Event event) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = event == Cycles;  // Members follow the leader
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (event) {
+            case Cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case Instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case LLCMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cacheEvent(PERF_COUNT_HW_CACHE_LL);
+                break;
+            case BranchMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case DTLBMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cacheEvent(PERF_COUNT_HW_CACHE_DTLB);
+                break;
+            default:
+                return;
+        }
+
+        int group = event == Cycles ? -1 : fds[Cycles];
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+        if (fd < 0) {
+            int err = errno;
+            if (event == Cycles) {
+                error_message = std::string("perf_event_open failed: ") + std::strerror(err);
+                if (err == EACCES || err == EPERM) {
+                    error_message += " (check /proc/sys/kernel/perf_event_paranoid)";
+                } else if (err == ENOENT || err == EOPNOTSUPP) {
+                    error_message += " (no hardware PMU, e.g. in a VM or container)";
+                }
+            }
+            return;
+        }
+        fds[event] = static_cast<int>(fd);
+    }
+
+    // Read misses of a cache level
+    static uint64_t cacheEvent(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+
+    std::array<int, NumEvents> fds;
+    std::string error_message;
+};
+
+}  // namespace sssp
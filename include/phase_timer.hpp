@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Wall time of named phases (parse, convert, setup, solve, ...), one
+ * sample per measurement. Phases keep the order they were first seen in,
+ * so reports list them in pipeline order.
+ *
+ *     PhaseTimer phases;
+ *     phases.measure("setup", [&] { ... });
+ *     {
+ *         auto scope = phases.scope("solve");
+ *         ...
+ *     }
+ *     double solve_ms = phases.median("solve");
+ */
+class PhaseTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Adds the time from construction to destruction to one phase
+    class Scope {
+    public:
+        Scope(PhaseTimer& timer, std::string name)
+            : timer(timer), name(std::move(name)), start(Clock::now()) {}
+        ~Scope() {
+            timer.add(name, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PhaseTimer& timer;
+        std::string name;
+        Clock::time_point start;
+    };
+
+    Scope scope(const std::string& name) { return Scope(*this, name); }
+
+    // Runs f and records its time; returns f's result
+    template <typename F>
+    decltype(auto) measure(const std::string& name, F&& f) {
+        Scope timed(*this, name);
+        return f();
+    }
+
+    void add(const std::string& name, double ms) { samples(name).push_back(ms); }
+
+    // Phase names in first-seen order
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+        for (const auto& phase : phases) result.push_back(phase.first);
+        return result;
+    }
+
+    bool has(const std::string& name) const { return find(name) != nullptr; }
+
+    // Every sample of a phase (empty if never measured)
+    const std::vector<double>& times(const std::string& name) const {
+        static const std::vector<double> none;
+        const auto* phase = find(name);
+        return phase ? *phase : none;
+    }
+
+    double total(const std::string& name) const {
+        double sum = 0;
+        for (double t : times(name)) sum += t;
+        return sum;
+    }
+
+    // Middle sample (upper middle for even counts); 0 if never measured
+    double median(const std::string& name) const {
+        std::vector<double> sorted = times(name);
+        if (sorted.empty()) return 0.0;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted[sorted.size() / 2];
+    }
+
+    void clear() { phases.clear(); }
+
+private:
+    const std::vector<double>* find(const std::string& name) const {
+        for (const auto& phase : phases) {
+            if (phase.first == name) return &phase.second;
+        }
+        return nullptr;
+    }
+
+    std::vector<double>& samples(const std::string& name) {
+        for (auto& phase : phases) {
+            if (phase.first == name) return phase.second;
+        }
+        phases.emplace_back(name, std::vector<double>());
+        return phases.back().second;
+    }
+
+    std::vector<std::pair<std::string, std::vector<double>>> phases;
+};
+
+}  // namespace sssp
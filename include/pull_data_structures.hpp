@@ -0,0 +1,280 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace sssp {
+
+/**
+ * Alternatives to BlockDataStructure for the D of BMSSP.
+ *
+ * BasicNewSSSP takes D as its third template parameter. Any type with the
+ * following members can be used:
+ *
+ * - KeyValue                          (vertex, distance) pair type
+ * - initialize(M, B, N)               empty D; pull size M, upper bound B,
+ *                                     about N insertions expected
+ * - insert(key, value)                add key, or lower its value
+ * - batchPrepend(vector<KeyValue>&)   add keys whose values are below those
+ *                                     already present (same keep-min rule)
+ * - pull() -> (keys, bound)           remove up to M smallest keys; bound is
+ *                                     the smallest value left, or B if empty
+ * - empty(), size()
+ *
+ * Both implementations keep one current value per key and drop superseded
+ * entries lazily when they surface.
+ */
+
+/**
+ * Binary min-heap with lazy deletion.
+ * insert and each element of batchPrepend: O(log N); pull: O(M log N).
+ * Unlike BlockDataStructure, pull always returns the exact M smallest keys.
+ */
+class HeapDataStructure {
+public:
+    using KeyValue = std::pair<int, double>;
+
+    HeapDataStructure() : M(1), B(std::numeric_limits<double>::infinity()) {}
+
+    void initialize(int m, double b, int max_n = 0) {
+        M = std::max(1, m);
+        B = b;
+        heap.clear();
+        key_values.clear();
+        if (max_n > 0) {
+            heap.reserve(max_n);
+        }
+    }
+
+    bool empty() const { return key_values.empty(); }
+    size_t size() const { return key_values.size(); }
+
+    void insert(int key, double value) {
+        auto [it, inserted] = key_values.try_emplace(key, value);
+        if (!inserted) {
+            if (value >= it->second) return;  // Keep existing smaller value
+            it->second = value;
+        }
+        heap.emplace_back(value, key);
+        std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+    }
+
+    void batchPrepend(std::vector<KeyValue>& items) {
+        for (const auto& [key, value] : items) {
+            insert(key, value);
+        }
+    }
+
+    std::pair<std::vector<int>, double> pull() {
+        std::vector<int> result;
+        while (static_cast<int>(result.size()) < M && !heap.empty()) {
+            Entry top = heap.front();
+            popTop();
+            if (isLive(top)) {
+                key_values.erase(top.second);
+                result.push_back(top.second);
+            }
+        }
+
+        // Separator: smallest live value left
+        while (!heap.empty() && !isLive(heap.front())) {
+            popTop();
+        }
+        double sep_bound = heap.empty() ? B : heap.front().first;
+        return {result, sep_bound};
+    }
+
+    double getValue(int key) const {
+        auto it = key_values.find(key);
+        return it != key_values.end() ? it->second : std::numeric_limits<double>::infinity();
+    }
+
+private:
+    using Entry = std::pair<double, int>;  // (value, key)
+
+    bool isLive(const Entry& e) const {
+        auto it = key_values.find(e.second);
+        return it != key_values.end() && it->second == e.first;
+    }
+
+    void popTop() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        heap.pop_back();
+    }
+
+    int M;
+    double B;
+    std::vector<Entry> heap;
+    std::unordered_map<int, double> key_values;
+};
+
+/**
+ * Radix heap over the bit patterns of the (non-negative) distances.
+ *
+ * Bucket 0 holds entries equal to `last`, the last extracted minimum;
+ * bucket i > 0 holds entries whose highest bit differing from `last` is
+ * bit i - 1. Emptying bucket 0 redistributes the next non-empty bucket
+ * around its minimum, so each entry moves down at most 64 times.
+ *
+ * The radix heap needs inserted values >= last. BMSSP mostly keeps that
+ * order. A smaller value redistributes all entries around it, which costs
+ * O(size) but keeps the result exact.
+ */
+class RadixDataStructure {
+public:
+    using KeyValue = std::pair<int, double>;
+
+    RadixDataStructure() : M(1), B(std::numeric_limits<double>::infinity()) {}
+
+    void initialize(int m, double b, int max_n = 0) {
+        (void)max_n;
+        M = std::max(1, m);
+        B = b;
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        key_values.clear();
+        last = 0;
+        rebuilds = 0;
+    }
+
+    bool empty() const { return key_values.empty(); }
+    size_t size() const { return key_values.size(); }
+
+    void insert(int key, double value) {
+        auto [it, inserted] = key_values.try_emplace(key, value);
+        if (!inserted) {
+            if (value >= it->second) return;  // Keep existing smaller value
+            it->second = value;
+        }
+
+        uint64_t bits = toBits(value);
+        if (bits < last) {
+            rebuild(bits);
+        }
+        buckets[bucketIndex(bits)].push_back({bits, key});
+    }
+
+    void batchPrepend(std::vector<KeyValue>& items) {
+        for (const auto& [key, value] : items) {
+            insert(key, value);
+        }
+    }
+
+    std::pair<std::vector<int>, double> pull() {
+        std::vector<int> result;
+        while (static_cast<int>(result.size()) < M && refill()) {
+            auto& front = buckets[0];
+            while (!front.empty() && static_cast<int>(result.size()) < M) {
+                Entry e = front.back();
+                front.pop_back();
+                if (isLive(e)) {
+                    key_values.erase(e.key);
+                    result.push_back(e.key);
+                }
+            }
+        }
+
+        double sep_bound = refill() ? toValue(last) : B;
+        return {result, sep_bound};
+    }
+
+    double getValue(int key) const {
+        auto it = key_values.find(key);
+        return it != key_values.end() ? it->second : std::numeric_limits<double>::infinity();
+    }
+
+    // Number of inserts below the current minimum since initialize()
+    size_t rebuildCount() const { return rebuilds; }
+
+private:
+    struct Entry {
+        uint64_t bits;
+        int key;
+    };
+
+    static uint64_t toBits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static double toValue(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    size_t bucketIndex(uint64_t bits) const {
+        return bits == last ? 0 : 64 - __builtin_clzll(bits ^ last);
+    }
+
+    bool isLive(const Entry& e) const {
+        auto it = key_values.find(e.key);
+        return it != key_values.end() && toBits(it->second) == e.bits;
+    }
+
+    // Make bucket 0 hold at least one live entry (all equal to last).
+    // Returns false if no live entry is left.
+    bool refill() {
+        for (;;) {
+            auto& front = buckets[0];
+            while (!front.empty() && !isLive(front.back())) {
+                front.pop_back();
+            }
+            if (!front.empty()) return true;
+
+            size_t i = 1;
+            while (i < buckets.size() && buckets[i].empty()) ++i;
+            if (i == buckets.size()) return false;
+
+            auto& source = buckets[i];
+            source.erase(std::remove_if(source.begin(), source.end(),
+                                        [this](const Entry& e) { return !isLive(e); }),
+                         source.end());
+            if (source.empty()) continue;
+
+            uint64_t min_bits = source.front().bits;
+            for (const auto& e : source) {
+                min_bits = std::min(min_bits, e.bits);
+            }
+            last = min_bits;
+
+            // Every entry lands in a bucket below i
+            std::vector<Entry> moving;
+            moving.swap(source);
+            for (const auto& e : moving) {
+                buckets[bucketIndex(e.bits)].push_back(e);
+            }
+        }
+    }
+
+    // Re-bucket everything around a new, smaller minimum
+    void rebuild(uint64_t new_last) {
+        rebuilds++;
+        std::vector<Entry> all;
+        for (auto& bucket : buckets) {
+            all.insert(all.end(), bucket.begin(), bucket.end());
+            bucket.clear();
+        }
+        last = new_last;
+        for (const auto& e : all) {
+            buckets[bucketIndex(e.bits)].push_back(e);
+        }
+    }
+
+    int M;
+    double B;
+    uint64_t last = 0;
+    size_t rebuilds = 0;
+    std::array<std::vector<Entry>, 65> buckets;
+    std::unordered_map<int, double> key_values;
+};
+
+}  // namespace sssp
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "graph_types.hpp"
+#include "graph_cache.hpp"
+#include "parallel_ranges.hpp"
+#include "trace_recorder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Synthetic road networks: planar-ish geometric graphs with coordinates,
+ * travel-time weights and a road hierarchy, for benchmarks without map data.
+ *
+ * Vertices are intersections of a rows x cols grid, each moved by a random
+ * jitter. Roads are two-way, with the same time both ways:
+ *
+ *   - local streets join grid neighbours; a share of the east-west ones is
+ *     missing, and some blocks are crossed by a diagonal street
+ *   - arterials run along every arterial_spacing-th row and column and are
+ *     never missing, so the network is connected
+ *   - highways run along every highway_spacing-th row and column, joining
+ *     only consecutive highway junctions, highway_spacing apart
+ *
+ * A road's time is its Euclidean length over the speed of its class, times
+ * a congestion factor in [1, 1 + congestion). Degrees stay low (about 3.8
+ * on average, at most 12) and the hop diameter grows with rows + cols.
+ *
+ * Every random choice is a hash of the seed and the vertex or road it is
+ * about, so a vertex's coordinates and roads are computed on their own in
+ * O(1): toSimpleGraph() builds vertices in parallel, and writeGraphFile()
+ * and writeMTX() stream tens of millions of vertices in bands of rows,
+ * with memory independent of the graph's size. The output depends only on
+ * the options, not on the thread count; a change to it bumps
+ * GraphGenerator::version.
+ *
+ *     RoadNetworkOptions options;
+ *     options.rows = options.cols = 6000;               // 36M vertices
+ *     RoadNetwork(options).writeGraphFile("roads.csr");  // then MappedGraph("roads.csr")
+ *     auto [x, y] = RoadNetwork(options).coordinates(v);
+ */
+enum class RoadClass { Local = 0, Arterial = 1, Highway = 2 };
+
+struct RoadNetworkOptions {
+    int rows = 1000;
+    int cols = 1000;
+    int arterial_spacing = 8;
+    int highway_spacing = 64;
+    double jitter = 0.3;          // Max displacement per axis, in grid units (< 0.5)
+    double missing_local = 0.25;  // Share of east-west local streets left out
+    double diagonal = 0.1;        // Share of blocks with a diagonal street
+    double congestion = 0.3;
+    double speed[3] = {1.0, 2.0, 4.0};  // Local, arterial, highway; grid units per time unit
+    unsigned seed = 42;
+};
+
+class RoadNetwork {
+public:
+    explicit RoadNetwork(const RoadNetworkOptions& options) : opt(options) {
+        if (opt.rows <= 0 || opt.cols <= 0 ||
+            static_cast<int64_t>(opt.rows) * opt.cols > INT32_MAX) {
+            throw std::invalid_argument("Road network needs 1 to 2^31 - 1 vertices");
+        }
+        if (opt.arterial_spacing <= 0 || opt.highway_spacing <= 0) {
+            throw std::invalid_argument("Road spacings must be positive");
+        }
+        for (double speed : opt.speed) {
+            if (!(speed > 0)) throw std::invalid_argument("Road speeds must be positive");
+        }
+        seed_hash = mix(0x9e3779b97f4a7c15ULL ^ opt.seed);
+    }
+
+    const RoadNetworkOptions& options() const { return opt; }
+
+    int vertices() const { return opt.rows * opt.cols; }
+
+    // Vertex at grid row r, column c
+    int vertex(int r, int c) const { return r * opt.cols + c; }
+
+    // (x, y) in grid units: column and row, plus jitter
+    std::pair<double, double> coordinates(int v) const {
+        int r = v / opt.cols, c = v % opt.cols;
+        return {c + opt.jitter * (2 * unit(JitterX, v) - 1),
+                r + opt.jitter * (2 * unit(JitterY, v) - 1)};
+    }
+
+    // Calls f(target, time, road class) for each road out of v, in a fixed order
+    template <typename F>
+    void forEachRoad(int v, F&& f) const {
+        const int rows = opt.rows, cols = opt.cols;
+        const int r = v / cols, c = v % cols;
+        auto road = [&](int to, Kind kind, int64_t id, RoadClass cls) {
+            f(to, time(v, to, kind, id, cls), cls);
+        };
+
+        if (r > 0) road(vertex(r - 1, c), North, vertex(r - 1, c), columnClass(c));
+        if (c > 0 && hasStreet(r, c - 1)) road(v - 1, East, v - 1, rowClass(r));
+        if (c + 1 < cols && hasStreet(r, c)) road(v + 1, East, v, rowClass(r));
+        if (r + 1 < rows) road(vertex(r + 1, c), North, v, columnClass(c));
+
+        // Diagonals: block (br, bc) has corners (br, bc) to (br + 1, bc + 1), crossed
+        // either from its top-left (orientation 0) or from its top-right (1)
+        auto diagonal = [&](int br, int bc, int orientation, int tr, int tc) {
+            if (br < 0 || bc < 0 || br + 1 >= rows || bc + 1 >= cols) return;
+            int64_t block = static_cast<int64_t>(br) * cols + bc;
+            if (unit(Diagonal, block) >= opt.diagonal) return;
+            if ((unit(DiagonalOrientation, block) < 0.5 ? 0 : 1) != orientation) return;
+            road(vertex(tr, tc), DiagonalRoad, block, RoadClass::Local);
+        };
+        diagonal(r - 1, c - 1, 0, r - 1, c - 1);
+        diagonal(r - 1, c, 1, r - 1, c + 1);
+        diagonal(r, c - 1, 1, r + 1, c - 1);
+        diagonal(r, c, 0, r + 1, c + 1);
+
+        const int h = opt.highway_spacing;
+        if (r % h == 0 && c % h == 0) {
+            if (r >= h) road(vertex(r - h, c), HighwayNorth, vertex(r - h, c), RoadClass::Highway);
+            if (c >= h) road(v - h, HighwayEast, v - h, RoadClass::Highway);
+            if (c + h < cols) road(v + h, HighwayEast, v, RoadClass::Highway);
+            if (r + h < rows) road(vertex(r + h, c), HighwayNorth, v, RoadClass::Highway);
+        }
+    }
+
+    int degree(int v) const {
+        int d = 0;
+        forEachRoad(v, [&](int, double, RoadClass) { d++; });
+        return d;
+    }
+
+    // The whole network in memory; vertices are built on `num_threads`
+    // threads (0 = one per hardware thread)
+    SimpleGraph toSimpleGraph(int num_threads = 0) const {
+        SSSP_TRACE_SCOPE("RoadNetwork::toSimpleGraph", "generator", "n", vertices());
+        const int n = vertices();
+        SimpleGraph g(n);
+        std::vector<int64_t> edges(detail::workerCount(n, num_threads), 0);
+        detail::parallelRanges(n, static_cast<int>(edges.size()), [&](int begin, int end, int t) {
+            for (int v = begin; v < end; ++v) {
+                forEachRoad(v, [&](int to, double w, RoadClass) { g.adj[v].emplace_back(to, w); });
+                edges[t] += static_cast<int64_t>(g.adj[v].size());
+            }
+        });
+        int64_t m = 0;
+        for (int64_t count : edges) m += count;
+        g.m = static_cast<int>(m);
+        return g;
+    }
+
+    // Streams the network to a graph file for MappedGraph / GraphCache
+    void writeGraphFile(const std::string& path, const std::string& key = "",
+                        int num_threads = 0) const {
+        SSSP_TRACE_SCOPE("RoadNetwork::writeGraphFile", "generator", "n", vertices());
+        struct Roads {
+            const std::pair<int, double>* first;
+            const std::pair<int, double>* last;
+            const std::pair<int, double>* begin() const { return first; }
+            const std::pair<int, double>* end() const { return last; }
+        };
+        GraphFileWriter writer(path, vertices(), key);
+        forEachBand(num_threads, [&](const Band& band) {
+            const std::pair<int, double>* next = band.roads.data();
+            for (int d : band.degrees) {
+                writer.addVertex(Roads{next, next + d});
+                next += d;
+            }
+        });
+        writer.finish();
+    }
+
+    // Streams the network as a general Matrix Market file, one line per
+    // road direction, for sssp_benchmark and other tools. The edge count in
+    // the header takes a counting pass first.
+    void writeMTX(const std::string& path, int num_threads = 0) const {
+        SSSP_TRACE_SCOPE("RoadNetwork::writeMTX", "generator", "n", vertices());
+        const int n = vertices();
+        int threads = detail::workerCount(n, num_threads);
+        std::vector<int64_t> counts(threads, 0);
+        detail::parallelRanges(n, threads, [&](int begin, int end, int t) {
+            for (int v = begin; v < end; ++v) counts[t] += degree(v);
+        });
+        int64_t m = 0;
+        for (int64_t count : counts) m += count;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Cannot write file: " + path);
+        out << "%%MatrixMarket matrix coordinate real general\n"
+            << "% Synthetic road network " << opt.rows << "x" << opt.cols
+            << ", seed " << opt.seed << "\n"
+            << n << " " << n << " " << m << "\n";
+        forEachBand(num_threads, [&](const Band& band) { out << band.text; }, true);
+        if (!out) throw std::runtime_error("Failed writing file: " + path);
+    }
+
+private:
+    enum Kind : uint64_t {
+        JitterX, JitterY, Street, Diagonal, DiagonalOrientation,
+        North, East, DiagonalRoad, HighwayNorth, HighwayEast
+    };
+
+    // Roads of a band of consecutive rows, in vertex order; as MTX lines if text
+    struct Band {
+        int first_row = 0;
+        int last_row = 0;
+        std::vector<int> degrees;
+        std::vector<std::pair<int, double>> roads;
+        std::string text;
+    };
+
+    // Bands of ~2^16 vertices, filled in waves of 4 per thread and handed
+    // to sink in order
+    template <typename Sink>
+    void forEachBand(int num_threads, Sink&& sink, bool text = false) const {
+        const int band_rows = std::max(1, (1 << 16) / opt.cols);
+        const int bands = (opt.rows + band_rows - 1) / band_rows;
+        const int threads = detail::workerCount(bands, num_threads);
+        std::vector<Band> wave(static_cast<size_t>(4) * threads);
+
+        for (int first = 0; first < bands; first += static_cast<int>(wave.size())) {
+            int count = std::min(static_cast<int>(wave.size()), bands - first);
+            detail::parallelRanges(count, threads, [&](int begin, int end, int) {
+                for (int b = begin; b < end; ++b) {
+                    Band& band = wave[b];
+                    band.first_row = (first + b) * band_rows;
+                    band.last_row = std::min(opt.rows, band.first_row + band_rows);
+                    fillBand(band, text);
+                }
+            });
+            for (int b = 0; b < count; ++b) sink(wave[b]);
+        }
+    }
+
+    void fillBand(Band& band, bool text) const {
+        band.degrees.clear();
+        band.roads.clear();
+        band.text.clear();
+        char line[64];
+        for (int v = vertex(band.first_row, 0); v < vertex(band.last_row, 0); ++v) {
+            int d = 0;
+            forEachRoad(v, [&](int to, double w, RoadClass) {
+                if (text) {
+                    int length = std::snprintf(line, sizeof(line), "%d %d %.9g\n", v + 1, to + 1, w);
+                    band.text.append(line, static_cast<size_t>(length));
+                } else {
+                    band.roads.emplace_back(to, w);
+                }
+                d++;
+            });
+            band.degrees.push_back(d);
+        }
+    }
+
+    RoadClass rowClass(int r) const {
+        return r % opt.arterial_spacing == 0 ? RoadClass::Arterial : RoadClass::Local;
+    }
+
+    RoadClass columnClass(int c) const {
+        return c % opt.arterial_spacing == 0 ? RoadClass::Arterial : RoadClass::Local;
+    }
+
+    // East-west street from (r, c) to (r, c + 1); arterials are never missing
+    bool hasStreet(int r, int c) const {
+        return rowClass(r) == RoadClass::Arterial ||
+               unit(Street, vertex(r, c)) >= opt.missing_local;
+    }
+
+    // Travel time of road `id` of `kind`, the same from either end
+    double time(int u, int v, Kind kind, int64_t id, RoadClass cls) const {
+        auto [ux, uy] = coordinates(u);
+        auto [vx, vy] = coordinates(v);
+        double length = std::hypot(ux - vx, uy - vy);
+        return length / opt.speed[static_cast<int>(cls)] * (1 + opt.congestion * unit(kind, id));
+    }
+
+    // splitmix64 finalizer
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // Uniform in [0, 1), a function of (seed, kind, index) only
+    double unit(Kind kind, int64_t index) const {
+        uint64_t bits = mix(seed_hash ^ mix((static_cast<uint64_t>(kind) << 56) ^
+                                            static_cast<uint64_t>(index)));
+        return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    RoadNetworkOptions opt;
+    uint64_t seed_hash = 0;
+};
+
+}  // namespace sssp
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "block_data_structure.hpp"
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace sssp {
+
+/**
+ * Block data structure that several threads can feed at once.
+ *
+ * Each writer thread owns one shard and appends its Insert and BatchPrepend
+ * items to that shard's buffers. The hot path takes no locks and shares no
+ * cache lines. Buffered items are merged into the underlying structure
+ * (Inner, by default LazyBlockDataStructure) when pull() or flush() runs.
+ * Writers must be quiescent at that point, for example after a join or a
+ * barrier.
+ *
+ * The merge is deterministic: pending items are sorted by (key, value) and
+ * only the smallest value per key is applied. The result does not depend on
+ * how the work was split over shards or on thread timing.
+ *
+ * The single-threaded insert/batchPrepend overloads write to shard 0, so the
+ * type can also be used directly as D in BasicNewSSSP.
+ */
+template <typename Inner = LazyBlockDataStructure>
+class ShardedBlockDataStructure {
+public:
+    using KeyValue = std::pair<int, double>;  // (vertex_id, distance)
+
+    explicit ShardedBlockDataStructure(int num_shards = 1)
+        : shards(std::max(1, num_shards)) {}
+
+    void initialize(int m, double b, int max_n = 0) {
+        inner.initialize(m, b, max_n);
+        for (auto& shard : shards) {
+            shard.inserts.clear();
+            shard.prepends.clear();
+        }
+    }
+
+    int shardCount() const { return static_cast<int>(shards.size()); }
+
+    // Concurrent writers: each thread uses its own shard index
+    void insert(int shard, int key, double value) {
+        shards[shard].inserts.emplace_back(key, value);
+    }
+
+    void batchPrepend(int shard, const std::vector<KeyValue>& items) {
+        auto& prepends = shards[shard].prepends;
+        prepends.insert(prepends.end(), items.begin(), items.end());
+    }
+
+    // Single writer (shard 0)
+    void insert(int key, double value) { insert(0, key, value); }
+    void batchPrepend(std::vector<KeyValue>& items) { batchPrepend(0, items); }
+
+    // Merge all buffered items into the underlying structure
+    void flush() {
+        std::vector<KeyValue> pending = gather(&Shard::inserts);
+        for (size_t i = 0; i < pending.size(); ++i) {
+            // Sorted by (key, value): the first item of each key is its minimum
+            if (i == 0 || pending[i].first != pending[i - 1].first) {
+                inner.insert(pending[i].first, pending[i].second);
+            }
+        }
+
+        pending = gather(&Shard::prepends);
+        if (!pending.empty()) {
+            inner.batchPrepend(pending);
+        }
+    }
+
+    std::pair<std::vector<int>, double> pull() {
+        flush();
+        return inner.pull();
+    }
+
+    bool empty() const { return inner.empty() && pendingCount() == 0; }
+
+    // Merged keys plus buffered items (a buffered key may be counted twice)
+    size_t size() const { return inner.size() + pendingCount(); }
+
+    const Inner& merged() const { return inner; }
+
+private:
+    // Own cache line per shard so writers do not false-share buffer headers
+    struct alignas(64) Shard {
+        std::vector<KeyValue> inserts;
+        std::vector<KeyValue> prepends;
+    };
+
+    // Concatenate one buffer of every shard, sorted by (key, value), and clear them
+    std::vector<KeyValue> gather(std::vector<KeyValue> Shard::*buffer) {
+        std::vector<KeyValue> all;
+        for (auto& shard : shards) {
+            auto& items = shard.*buffer;
+            all.insert(all.end(), items.begin(), items.end());
+            items.clear();
+        }
+        std::sort(all.begin(), all.end());
+        return all;
+    }
+
+    size_t pendingCount() const {
+        size_t count = 0;
+        for (const auto& shard : shards) {
+            count += shard.inserts.size() + shard.prepends.size();
+        }
+        return count;
+    }
+
+    std::vector<Shard> shards;
+    Inner inner;
+};
+
+}  // namespace sssp
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "graph_types.hpp"
+#include "parallel_ranges.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Checks a solver's output as a shortest-path certificate, in O(n + m)
+ * and without a reference run.
+ *
+ * For nonnegative weights, distances d and predecessors p are correct iff:
+ *
+ *   - d[source] == 0 and p[source] == -1
+ *   - no edge can improve d: d[v] <= d[u] + w for every edge (u, v) with
+ *     d[u] finite (so an edge from a reached vertex also reaches v)
+ *   - every other reached v has a tight predecessor edge: p[v] -> v exists
+ *     and d[v] == d[p[v]] + w
+ *   - predecessor chains of reached vertices end at the source, and
+ *     unreached vertices have d == INF and p == -1
+ *
+ * The edge scan runs on `num_threads` threads (0 = one per hardware
+ * thread), each over a contiguous range of vertices, so the result does
+ * not depend on the thread count. The chain check is one sequential O(n)
+ * pass. Without predecessors, each reached vertex needs some tight
+ * in-edge instead, and chains are not checked. With zero-weight edges,
+ * tight in-edges alone do not rule out a cycle of them unconnected to
+ * the source.
+ *
+ * Equalities hold within `tolerance` (absolute, as for the distance
+ * comparisons elsewhere).
+ *
+ *     auto check = verifyShortestPaths(graph, source, dist, pred);
+ *     if (!check.valid()) std::cerr << check.violated_edges << " edges violated\n";
+ */
+struct CertificateCheck {
+    bool source_ok = false;        // d[source] == 0 (and no predecessor)
+    size_t reached = 0;            // Vertices with finite distance
+    size_t violated_edges = 0;     // Edges (u, v) with d[v] > d[u] + w
+    size_t untight_vertices = 0;   // Reached vertices without a tight predecessor edge
+    size_t unrooted_vertices = 0;  // Reached but not chained to the source, or unreached with a predecessor
+    int first_bad_vertex = -1;     // Smallest vertex involved in any failure (-1 if none)
+    bool checked_predecessors = false;
+
+    bool valid() const {
+        return source_ok && violated_edges == 0 && untight_vertices == 0 && unrooted_vertices == 0;
+    }
+};
+
+// predecessors may be null (distance-only solvers)
+template <typename GraphT>
+CertificateCheck verifyShortestPaths(const GraphT& graph, int source, const double* distances,
+                                     const int* predecessors, int num_threads = 0,
+                                     double tolerance = 1e-6) {
+    const int n = graph.n;
+    CertificateCheck check;
+    check.checked_predecessors = predecessors != nullptr;
+    check.source_ok = distances[source] == 0.0 &&
+                      (!predecessors || predecessors[source] == -1);
+
+    // tight[v]: a tight edge into v was seen (from p[v] when predecessors are given)
+    std::unique_ptr<std::atomic<uint8_t>[]> tight(new std::atomic<uint8_t>[n]);
+    for (int v = 0; v < n; ++v) tight[v].store(0, std::memory_order_relaxed);
+
+    struct Partial {
+        size_t violated = 0;
+        int first_bad = -1;
+    };
+    int threads = detail::workerCount(n, num_threads);
+    std::vector<Partial> partials(threads);
+
+    detail::parallelRanges(n, threads, [&](int begin, int end, int t) {
+        Partial& partial = partials[t];
+        for (int u = begin; u < end; ++u) {
+            double du = distances[u];
+            if (!(du < INF)) continue;
+            for (const auto& [v, w] : graph.outEdges(u)) {
+                double through = du + w;
+                double dv = distances[v];
+                if (dv > through + tolerance) {
+                    partial.violated++;
+                    if (partial.first_bad < 0) partial.first_bad = v;
+                }
+                if (std::abs(dv - through) <= tolerance && (!predecessors || predecessors[v] == u)) {
+                    tight[v].store(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+
+    int first_bad = -1;
+    auto noteBad = [&](int v) {
+        if (v >= 0 && (first_bad < 0 || v < first_bad)) first_bad = v;
+    };
+    if (!check.source_ok) noteBad(source);
+    for (const auto& partial : partials) {
+        check.violated_edges += partial.violated;
+        noteBad(partial.first_bad);
+    }
+
+    // 0 = not yet known, 1 = chained to the source, 2 = not chained,
+    // 3 = on the chain being followed
+    std::vector<uint8_t> rooted(predecessors ? n : 0, 0);
+    std::vector<int> chain;
+    if (predecessors) rooted[source] = 1;
+
+    for (int v = 0; v < n; ++v) {
+        bool reached = distances[v] < INF;
+        if (!reached) {
+            if (predecessors && predecessors[v] != -1) {
+                check.unrooted_vertices++;
+                noteBad(v);
+            }
+            continue;
+        }
+        check.reached++;
+        if (v == source) continue;
+        if (!tight[v].load(std::memory_order_relaxed)) {
+            check.untight_vertices++;
+            noteBad(v);
+        }
+        if (!predecessors) continue;
+
+        // Follow p until a vertex of known state, an invalid entry or a repeat
+        chain.clear();
+        int x = v;
+        uint8_t state = 0;
+        while (true) {
+            if (x < 0 || x >= n || !(distances[x] < INF)) {
+                state = 2;
+                break;
+            }
+            if (rooted[x] != 0) {
+                state = rooted[x] == 3 ? 2 : rooted[x];  // Back on the chain: a cycle
+                break;
+            }
+            rooted[x] = 3;
+            chain.push_back(x);
+            x = predecessors[x];
+        }
+        for (int y : chain) rooted[y] = state;
+        if (state == 2) {
+            check.unrooted_vertices++;
+            noteBad(v);
+        }
+    }
+
+    check.first_bad_vertex = first_bad;
+    return check;
+}
+
+template <typename GraphT>
+CertificateCheck verifyShortestPaths(const GraphT& graph, int source,
+                                     const std::vector<double>& distances,
+                                     const std::vector<int>& predecessors, int num_threads = 0,
+                                     double tolerance = 1e-6) {
+    return verifyShortestPaths(graph, source, distances.data(),
+                               predecessors.empty() ? nullptr : predecessors.data(),
+                               num_threads, tolerance);
+}
+
+}  // namespace sssp
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "new_sssp.hpp"
+#include "dijkstra_lemon.hpp"
+#include "phase_timer.hpp"
+#include "shortest_path_certificate.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * One end-to-end solve per algorithm, split into separately timed phases:
+ *
+ *   convert  copy into the solver's own graph format (LEMON only)
+ *   setup    solver construction and output buffers
+ *   solve    the search itself
+ *   extract  a caller-owned copy of distances and predecessors
+ *   verify   shortest-path certificate of the result (only if asked for)
+ *
+ * Each phase is added to the given PhaseTimer, so repeated calls build a
+ * distribution per phase. Loading (parse, CSR build) is timed by the tools.
+ * The certificate (shortest_path_certificate.hpp) needs no reference run.
+ */
+struct PhasedSolve {
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    CertificateCheck certificate;  // Left default unless verified
+};
+
+inline constexpr const char* phase_names[] = {"convert", "setup", "solve", "extract", "verify"};
+
+// Vertices whose distance differs from the reference (reachability included)
+inline int countMismatches(const std::vector<double>& distances,
+                           const std::vector<double>& reference, double tolerance = 1e-6) {
+    int mismatches = 0;
+    for (size_t i = 0; i < reference.size(); ++i) {
+        bool reached = distances[i] < INF;
+        if (reached != (reference[i] < INF) ||
+            (reached && std::abs(distances[i] - reference[i]) > tolerance)) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+namespace detail {
+
+template <typename GraphT>
+void verify(const GraphT& graph, int source, PhaseTimer& timer, PhasedSolve& out, bool enabled) {
+    if (enabled) {
+        out.certificate = timer.measure("verify", [&] {
+            return verifyShortestPaths(graph, source, out.distances, out.predecessors);
+        });
+    }
+}
+
+}  // namespace detail
+
+template <typename GraphT>
+PhasedSolve solveSimpleDijkstraInPhases(const GraphT& graph, int source, PhaseTimer& timer,
+                                        bool verify = false) {
+    PhasedSolve out;
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    timer.measure("setup", [&] {
+        distances.resize(graph.n);
+        predecessors.resize(graph.n);
+    });
+    timer.measure("solve", [&] {
+        SimpleDijkstra::solve(graph, source, distances.data(), predecessors.data());
+    });
+    timer.measure("extract", [&] {
+        out.distances = distances;
+        out.predecessors = predecessors;
+    });
+    detail::verify(graph, source, timer, out, verify);
+    return out;
+}
+
+template <typename GraphT>
+PhasedSolve solveLemonInPhases(const GraphT& graph, int source, PhaseTimer& timer,
+                               bool verify = false) {
+    PhasedSolve out;
+    Graph lemon_graph;
+    WeightMap weights(lemon_graph);
+    std::vector<Node> nodes;
+    timer.measure("convert", [&] { nodes = DijkstraLemon::buildGraph(graph, lemon_graph, weights); });
+
+    // LEMON keeps its results in maps; buffers receive them on extraction
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    auto dijkstra = timer.measure("setup", [&] {
+        distances.resize(graph.n);
+        predecessors.resize(graph.n);
+        return std::make_unique<DijkstraLemon::Engine>(lemon_graph, weights);
+    });
+    timer.measure("solve", [&] { dijkstra->run(nodes[source]); });
+    timer.measure("extract", [&] {
+        DijkstraLemon::extract(lemon_graph, *dijkstra, distances.data(), predecessors.data());
+        out.distances = std::move(distances);
+        out.predecessors = std::move(predecessors);
+    });
+    detail::verify(graph, source, timer, out, verify);
+    return out;
+}
+
+template <typename GraphT>
+PhasedSolve solveNewSSSPInPhases(const GraphT& graph, int source, PhaseTimer& timer,
+                                 bool verify = false) {
+    PhasedSolve out;
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    auto solver = timer.measure("setup", [&] {
+        distances.resize(graph.n);
+        predecessors.resize(graph.n);
+        return std::make_unique<BasicNewSSSP<DefaultPolicy, GraphT>>(graph);
+    });
+    timer.measure("solve", [&] { solver->solve(source, distances, predecessors); });
+    timer.measure("extract", [&] {
+        out.distances = distances;
+        out.predecessors = predecessors;
+    });
+    detail::verify(graph, source, timer, out, verify);
+    return out;
+}
+
+}  // namespace sssp
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <type_traits>
+
+namespace sssp {
+
+/**
+ * Compile-time feature selection for the solvers.
+ *
+ * A policy is any type with the static constexpr members below. Features
+ * that are switched off are removed with `if constexpr`, so a distance-only
+ * solver carries no predecessor writes, counter increments or trace hooks.
+ *
+ * - track_predecessors: maintain the predecessor array
+ * - count_operations:   hot-path counters (relaxations, ...)
+ * - trace:              record the BMSSP call sequence
+ * - level_stats:        per-recursion-level counters and wall time (NewSSSP)
+ *
+ * An optional `distance_type` is the type distance arithmetic and
+ * comparisons run in (double if absent). Distances are still stored and
+ * returned as double; a wrapped type such as CountedDouble
+ * (counted_number.hpp) only observes the operations.
+ */
+template <bool TrackPredecessors, bool CountOperations, bool Trace, bool LevelStats = false,
+          typename Distance = double>
+struct SolverPolicy {
+    static constexpr bool track_predecessors = TrackPredecessors;
+    static constexpr bool count_operations = CountOperations;
+    static constexpr bool trace = Trace;
+    static constexpr bool level_stats = LevelStats;
+    using distance_type = Distance;
+};
+
+namespace detail {
+
+template <typename Policy, typename = void>
+struct policy_distance {
+    using type = double;
+};
+
+template <typename Policy>
+struct policy_distance<Policy, std::void_t<typename Policy::distance_type>> {
+    using type = typename Policy::distance_type;
+};
+
+}  // namespace detail
+
+// Policy::distance_type, or double for policies that do not declare one
+template <typename Policy>
+using policy_distance_t = typename detail::policy_distance<Policy>::type;
+
+// Current behaviour: predecessors and counters, no tracing
+using DefaultPolicy = SolverPolicy<true, true, false>;
+
+// Distances only, no instrumentation
+using DistanceOnlyPolicy = SolverPolicy<false, false, false>;
+
+// Default plus the per-level breakdown, for tuning runs
+using ProfilingPolicy = SolverPolicy<true, true, false, true>;
+
+// Everything on, for debugging and profiling
+using TracingPolicy = SolverPolicy<true, true, true, true>;
+
+}  // namespace sssp
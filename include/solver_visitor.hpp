@@ -0,0 +1,69 @@
+#pragma once
+
+#include <type_traits>
+
+namespace sssp {
+
+/**
+ * Visitor interface for SimpleDijkstra and NewSSSP.
+ *
+ * Derive from NullVisitor and redeclare only the hooks you need:
+ *
+ * - discover(v, dist):         v gets its first finite distance
+ * - relax(u, v, w, new_dist):  edge (u, v) is about to improve v
+ * - settle(u, dist):           u is final (Dijkstra: popped; NewSSSP: extracted by the
+ *                              base case or returned by a completed BMSSP call)
+ * - finish():                  the solve is over (also after a Stop)
+ *
+ * Hooks return a VisitAction:
+ * - Continue: proceed normally
+ * - Prune:    discover/relax - drop this update; settle - do not expand u. NewSSSP
+ *             settles before expanding only for the source and base-case
+ *             extractions; a vertex settled from a returned U or when the
+ *             search ends was already expanded, and Prune then has no effect.
+ * - Stop:     end the solve; distances found so far are kept
+ *
+ * Hooks inherited unchanged from NullVisitor are detected at compile time
+ * and never called, so a no-op visitor compiles to the plain solver loops.
+ */
+enum class VisitAction { Continue, Prune, Stop };
+
+struct NullVisitor {
+    VisitAction discover(int /*v*/, double /*dist*/) { return VisitAction::Continue; }
+    VisitAction relax(int /*u*/, int /*v*/, double /*w*/, double /*new_dist*/) {
+        return VisitAction::Continue;
+    }
+    VisitAction settle(int /*u*/, double /*dist*/) { return VisitAction::Continue; }
+    void finish() {}
+};
+
+namespace detail {
+
+// A hook is active if the visitor declares it itself rather than inheriting
+// it from NullVisitor (the member pointer then has a different class type).
+template <typename V>
+constexpr bool overrides_discover =
+    !std::is_same_v<decltype(&V::discover), decltype(&NullVisitor::discover)>;
+template <typename V>
+constexpr bool overrides_relax =
+    !std::is_same_v<decltype(&V::relax), decltype(&NullVisitor::relax)>;
+template <typename V>
+constexpr bool overrides_settle =
+    !std::is_same_v<decltype(&V::settle), decltype(&NullVisitor::settle)>;
+template <typename V>
+constexpr bool overrides_finish =
+    !std::is_same_v<decltype(&V::finish), decltype(&NullVisitor::finish)>;
+
+}  // namespace detail
+
+template <typename V>
+struct VisitorTraits {
+    static constexpr bool discover = detail::overrides_discover<V>;
+    static constexpr bool relax = detail::overrides_relax<V>;
+    static constexpr bool settle = detail::overrides_settle<V>;
+    static constexpr bool finish = detail::overrides_finish<V>;
+    // Any hook that returns an action may stop the solve
+    static constexpr bool can_stop = discover || relax || settle;
+};
+
+}  // namespace sssp
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Source selection for multi-source benchmarks.
+ *
+ * Benchmarking from vertex 0 alone is meaningless when vertex 0 reaches a
+ * handful of vertices. Sources are instead drawn from the largest strongly
+ * connected component, so each one reaches at least that component (for an
+ * undirected graph stored as both arcs, it is the largest connected
+ * component).
+ *
+ *     auto region = largestStronglyConnectedComponent(graph);
+ *     auto sources = sampleSources(graph, region, 32, SourceSampling::Degree, seed);
+ */
+enum class SourceSampling { Uniform, Degree };
+
+inline const char* sourceSamplingName(SourceSampling mode) {
+    return mode == SourceSampling::Uniform ? "uniform" : "degree";
+}
+
+// Vertices of the largest SCC, ascending (iterative Tarjan, O(n + m))
+template <typename GraphT>
+std::vector<int> largestStronglyConnectedComponent(const GraphT& graph) {
+    const int n = graph.n;
+    std::vector<int> index(n, -1), low(n, 0);
+    std::vector<char> on_stack(n, 0);
+    std::vector<int> stack;
+    std::vector<std::pair<int, size_t>> call;  // (vertex, next out-edge)
+    std::vector<int> best, component;
+    int next_index = 0;
+
+    for (int root = 0; root < n; ++root) {
+        if (index[root] >= 0) continue;
+        call.emplace_back(root, 0);
+        index[root] = low[root] = next_index++;
+        stack.push_back(root);
+        on_stack[root] = 1;
+
+        while (!call.empty()) {
+            auto& [u, edge] = call.back();
+            const auto& edges = graph.outEdges(u);
+            if (edge < edges.size()) {
+                int v = edges[edge++].first;
+                if (index[v] < 0) {
+                    index[v] = low[v] = next_index++;
+                    stack.push_back(v);
+                    on_stack[v] = 1;
+                    call.emplace_back(v, 0);
+                } else if (on_stack[v]) {
+                    low[u] = std::min(low[u], index[v]);
+                }
+                continue;
+            }
+
+            int finished = u;
+            call.pop_back();
+            if (!call.empty()) {
+                int parent = call.back().first;
+                low[parent] = std::min(low[parent], low[finished]);
+            }
+            if (low[finished] != index[finished]) continue;
+
+            component.clear();
+            int v;
+            do {
+                v = stack.back();
+                stack.pop_back();
+                on_stack[v] = 0;
+                component.push_back(v);
+            } while (v != finished);
+            if (component.size() > best.size()) best.swap(component);
+        }
+    }
+
+    std::sort(best.begin(), best.end());
+    return best;
+}
+
+/**
+ * `count` distinct vertices of `candidates` (all of them if there are
+ * fewer), uniformly or with probability proportional to out-degree
+ * (Efraimidis-Spirakis keys). Deterministic for a given seed.
+ */
+template <typename GraphT>
+std::vector<int> sampleSources(const GraphT& graph, const std::vector<int>& candidates,
+                               int count, SourceSampling mode, uint32_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::vector<std::pair<double, int>> keyed;
+    keyed.reserve(candidates.size());
+    for (int v : candidates) {
+        double r = uniform(rng);
+        double key = r;
+        if (mode == SourceSampling::Degree) {
+            // u^(1/w); vertices without out-edges are never picked before the rest
+            double w = static_cast<double>(graph.outEdges(v).size());
+            key = w > 0 ? std::pow(r, 1.0 / w) : -1.0 + r;
+        }
+        keyed.emplace_back(key, v);
+    }
+
+    size_t k = std::min(candidates.size(), static_cast<size_t>(std::max(count, 0)));
+    std::partial_sort(keyed.begin(), keyed.begin() + k, keyed.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<int> sources;
+    sources.reserve(k);
+    for (size_t i = 0; i < k; ++i) sources.push_back(keyed[i].second);
+    return sources;
+}
+
+}  // namespace sssp
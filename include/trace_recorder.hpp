@@ -0,0 +1,242 @@
+#pragma once
+
+#include "json_writer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sssp {
+
+/**
+ * Timeline recorder for the solvers and loaders, exported as Chrome trace
+ * JSON (chrome://tracing, https://ui.perfetto.dev).
+ *
+ * Instrumented code marks regions with SSSP_TRACE_SCOPE(name, category
+ * [, arg_name, arg_value [, arg_name, arg_value]]). The hooks are compiled
+ * only when SSSP_ENABLE_TRACING is defined (the CMake option of the same
+ * name, off by default); otherwise the macro expands to nothing and its
+ * arguments are not evaluated. With hooks compiled in, a scope costs one
+ * atomic load while no recorder is active, and two clock reads plus one
+ * slot write while one is.
+ *
+ * Events go into a fixed-size ring buffer. When it wraps, the oldest events
+ * are overwritten and counted in dropped(). Several threads may record at
+ * once; each gets a small thread id in the trace. Names and argument names
+ * must be string literals (or otherwise outlive the recorder).
+ *
+ *     TraceRecorder recorder;
+ *     recorder.start();
+ *     solver.solve(source);
+ *     recorder.stop();
+ *     recorder.writeChromeTrace("trace.json");
+ */
+struct TraceEvent {
+    const char* name = nullptr;
+    const char* category = nullptr;
+    int64_t start_ns = 0;     // Since the recorder was created
+    int64_t duration_ns = 0;  // < 0 for an instant event
+    uint32_t thread = 0;
+    uint32_t num_args = 0;
+    const char* arg_names[2] = {nullptr, nullptr};
+    double arg_values[2] = {0, 0};
+};
+
+class TraceRecorder {
+public:
+    static constexpr size_t default_capacity = size_t(1) << 20;
+
+    explicit TraceRecorder(size_t capacity = default_capacity)
+        : ring(capacity > 0 ? capacity : 1), epoch(std::chrono::steady_clock::now()) {}
+
+    ~TraceRecorder() { stop(); }
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Recorder that SSSP_TRACE_SCOPE writes to, or null
+    static TraceRecorder* active() { return active_recorder.load(std::memory_order_relaxed); }
+
+    void start() { active_recorder.store(this, std::memory_order_relaxed); }
+
+    void stop() {
+        TraceRecorder* self = this;
+        active_recorder.compare_exchange_strong(self, nullptr, std::memory_order_relaxed);
+    }
+
+    int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    void record(const TraceEvent& event) {
+        size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+        ring[slot % ring.size()] = event;
+    }
+
+    void instant(const char* name, const char* category) {
+        TraceEvent event;
+        event.name = name;
+        event.category = category;
+        event.start_ns = now();
+        event.duration_ns = -1;
+        event.thread = threadId();
+        record(event);
+    }
+
+    size_t capacity() const { return ring.size(); }
+    size_t size() const { return std::min(recorded(), ring.size()); }
+    size_t dropped() const { return recorded() - size(); }
+
+    void clear() { next.store(0, std::memory_order_relaxed); }
+
+    // Retained events, oldest first. Writers must be quiescent.
+    std::vector<TraceEvent> events() const {
+        size_t total = recorded();
+        size_t kept = size();
+        std::vector<TraceEvent> result;
+        result.reserve(kept);
+        for (size_t i = total - kept; i < total; ++i) {
+            result.push_back(ring[i % ring.size()]);
+        }
+        return result;
+    }
+
+    void writeChromeTrace(std::ostream& out) const {
+        JsonWriter json(out);
+        json.beginObject();
+        json.key("traceEvents").beginArray();
+
+        json.beginObject();
+        json.key("name").value("process_name");
+        json.key("ph").value("M");
+        json.key("pid").value(1);
+        json.key("tid").value(0);
+        json.key("args").beginObject().key("name").value("sssp").endObject();
+        json.endObject();
+
+        for (const auto& event : events()) {
+            json.beginObject();
+            json.key("name").value(event.name);
+            json.key("cat").value(event.category);
+            json.key("pid").value(1);
+            json.key("tid").value(event.thread);
+            json.key("ts").value(event.start_ns / 1000.0);
+            if (event.duration_ns >= 0) {
+                json.key("ph").value("X");
+                json.key("dur").value(event.duration_ns / 1000.0);
+            } else {
+                json.key("ph").value("i");
+                json.key("s").value("t");
+            }
+            if (event.num_args > 0) {
+                json.key("args").beginObject();
+                for (uint32_t a = 0; a < event.num_args; ++a) {
+                    json.key(event.arg_names[a]).value(event.arg_values[a]);
+                }
+                json.endObject();
+            }
+            json.endObject();
+        }
+
+        json.endArray();
+        json.key("displayTimeUnit").value("ms");
+        json.key("otherData").beginObject();
+        json.key("dropped_events").value(dropped());
+        json.endObject();
+        json.endObject();
+        out << "\n";
+    }
+
+    bool writeChromeTrace(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        writeChromeTrace(out);
+        return static_cast<bool>(out);
+    }
+
+    // Small per-thread id, in order of first use
+    static uint32_t threadId() {
+        static std::atomic<uint32_t> next_thread{0};
+        thread_local uint32_t id = next_thread.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+private:
+    size_t recorded() const { return next.load(std::memory_order_relaxed); }
+
+    static inline std::atomic<TraceRecorder*> active_recorder{nullptr};
+
+    std::vector<TraceEvent> ring;
+    std::atomic<size_t> next{0};
+    std::chrono::steady_clock::time_point epoch;
+};
+
+/**
+ * Records one complete event from construction to destruction, into the
+ * recorder that was active at construction (nothing if none was).
+ */
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category) : recorder(TraceRecorder::active()) {
+        if (recorder) {
+            event.name = name;
+            event.category = category;
+            event.start_ns = recorder->now();
+        }
+    }
+
+    template <typename T>
+    TraceScope(const char* name, const char* category, const char* arg_name, T arg_value)
+        : TraceScope(name, category) {
+        arg(arg_name, arg_value);
+    }
+
+    template <typename T, typename U>
+    TraceScope(const char* name, const char* category,
+               const char* arg_name, T arg_value, const char* arg2_name, U arg2_value)
+        : TraceScope(name, category) {
+        arg(arg_name, arg_value);
+        arg(arg2_name, arg2_value);
+    }
+
+    ~TraceScope() {
+        if (recorder) {
+            event.duration_ns = recorder->now() - event.start_ns;
+            event.thread = TraceRecorder::threadId();
+            recorder->record(event);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    // Attach a numeric argument (at most two per event)
+    template <typename T>
+    void arg(const char* arg_name, T value) {
+        if (recorder && event.num_args < 2) {
+            event.arg_names[event.num_args] = arg_name;
+            event.arg_values[event.num_args] = static_cast<double>(value);
+            event.num_args++;
+        }
+    }
+
+private:
+    TraceRecorder* recorder;
+    TraceEvent event;
+};
+
+}  // namespace sssp
+
+#define SSSP_TRACE_CONCAT_INNER(a, b) a##b
+#define SSSP_TRACE_CONCAT(a, b) SSSP_TRACE_CONCAT_INNER(a, b)
+
+#ifdef SSSP_ENABLE_TRACING
+#define SSSP_TRACE_SCOPE(...) \
+    ::sssp::TraceScope SSSP_TRACE_CONCAT(sssp_trace_scope_, __LINE__)(__VA_ARGS__)
+#else
+#define SSSP_TRACE_SCOPE(...) static_cast<void>(0)
+#endif
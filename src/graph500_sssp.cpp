@@ -0,0 +1,334 @@
+/**
+ * Graph500 SSSP Benchmark
+ *
+ * Generates a Graph500 R-MAT graph and runs the SSSP kernel of every
+ * solver from sampled roots, validating each search and reporting the
+ * harmonic-mean traversed edges per second (TEPS).
+ *
+ * Usage: ./graph500_sssp [scale] [edge_factor] [options]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+#include "graph_generator.hpp"
+#include "graph500.hpp"
+#include "new_sssp.hpp"
+#include "dijkstra_lemon.hpp"
+#include "json_writer.hpp"
+#include "benchmark_env.hpp"
+
+using namespace sssp;
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [scale] [edge_factor] [options]\n";
+    std::cerr << "\n";
+    std::cerr << "Arguments:\n";
+    std::cerr << "  scale        log2 of the number of vertices (default: 16)\n";
+    std::cerr << "  edge_factor  Undirected edges per vertex (default: 16)\n";
+    std::cerr << "\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --roots <n>          Search roots (default: 64)\n";
+    std::cerr << "  --seed <n>           Seed of the generator and the roots (default: 1)\n";
+    std::cerr << "  --abcd <a,b,c,d>     R-MAT quadrant probabilities (default: 0.57,0.19,0.19,0.05)\n";
+    std::cerr << "  --solvers <list>     Comma-separated subset of dijkstra, lemon, new (default: all)\n";
+    std::cerr << "  --threads <n>        Generator and validation threads (default: all)\n";
+    std::cerr << "  --pin <cpu>          Pin the benchmark to one CPU (generation stays parallel)\n";
+    std::cerr << "  --json <file>        Write every search and the summary of each solver as JSON\n";
+    std::cerr << "\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  " << program << " 20 16 --roots 64 --json graph500.json\n";
+    std::cerr << "  " << program << " 24 16 --solvers dijkstra,lemon --pin 2\n";
+}
+
+void printSeparator(char c = '=', int width = 70) {
+    std::cout << std::string(width, c) << "\n";
+}
+
+struct SolverKernel {
+    std::string name;
+    Graph500Kernel kernel;
+};
+
+bool writeJson(const std::string& path, int scale, int edge_factor, const double (&abcd)[4],
+               uint32_t seed, const SimpleGraph& graph, double generation_s,
+               const std::vector<SolverKernel>& solvers) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    JsonWriter json(out);
+    json.beginObject();
+    json.key("scale").value(scale);
+    json.key("edge_factor").value(edge_factor);
+    json.key("abcd").beginArray();
+    for (double p : abcd) json.value(p);
+    json.endArray();
+    json.key("seed").value(seed);
+    json.key("n").value(graph.n);
+    json.key("m").value(graph.m);
+    json.key("generation_s").value(generation_s);
+    json.key("solvers").beginArray();
+    for (const auto& solver : solvers) {
+        const auto& kernel = solver.kernel;
+        auto stats = kernel.tepsStats();
+        json.beginObject();
+        json.key("name").value(solver.name);
+        json.key("validated").value(kernel.validated());
+        // A solver with any failed search has no TEPS figure (null)
+        bool valid = kernel.validated() == kernel.searches.size();
+        double none = std::numeric_limits<double>::quiet_NaN();
+        json.key("harmonic_mean_teps").value(valid ? kernel.harmonicMeanTEPS() : none);
+        json.key("min_teps").value(valid ? stats.min : none);
+        json.key("median_teps").value(valid ? stats.median : none);
+        json.key("max_teps").value(valid ? stats.max : none);
+        json.key("searches").beginArray();
+        for (const auto& search : kernel.searches) {
+            json.beginObject();
+            json.key("root").value(search.root);
+            json.key("seconds").value(search.seconds);
+            json.key("traversed_edges").value(search.traversed_edges);
+            json.key("teps").value(search.teps());
+            json.key("valid").value(search.valid);
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    out << "\n";
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char* argv[]) {
+    // Options may appear anywhere; the rest are positional
+    std::vector<std::string> positional;
+    std::string json_path;
+    std::string abcd_text = "0.57,0.19,0.19,0.05";
+    std::string solver_list = "dijkstra,lemon,new";
+    int num_roots = 64;
+    uint32_t seed = 1;
+    int threads = 0;
+    int pin_cpu = -1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool takes_value = arg == "--roots" || arg == "--seed" || arg == "--abcd" ||
+                           arg == "--solvers" || arg == "--threads" || arg == "--pin" ||
+                           arg == "--json";
+        if (takes_value) {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            const char* value = argv[++i];
+            if (arg == "--roots") {
+                num_roots = std::max(1, std::atoi(value));
+            } else if (arg == "--seed") {
+                seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else if (arg == "--abcd") {
+                abcd_text = value;
+            } else if (arg == "--solvers") {
+                solver_list = value;
+            } else if (arg == "--threads") {
+                threads = std::max(0, std::atoi(value));
+            } else if (arg == "--pin") {
+                pin_cpu = std::atoi(value);
+            } else {
+                json_path = value;
+            }
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    int scale = positional.size() > 0 ? std::atoi(positional[0].c_str()) : 16;
+    int edge_factor = positional.size() > 1 ? std::atoi(positional[1].c_str()) : 16;
+    if (scale < 1 || scale > 30 || edge_factor < 1) {
+        std::cerr << "Invalid scale or edge factor: " << scale << ", " << edge_factor << "\n";
+        return 1;
+    }
+
+    double abcd[4];
+    {
+        std::istringstream in(abcd_text);
+        char comma;
+        in >> abcd[0] >> comma >> abcd[1] >> comma >> abcd[2] >> comma >> abcd[3];
+        if (!in || abcd[0] < 0 || abcd[1] < 0 || abcd[2] < 0 || abcd[3] < 0 ||
+            abcd[0] + abcd[1] + abcd[2] + abcd[3] <= 0) {
+            std::cerr << "Invalid --abcd: " << abcd_text << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<std::string> selected;
+    {
+        std::istringstream in(solver_list);
+        std::string name;
+        while (std::getline(in, name, ',')) {
+            if (name != "dijkstra" && name != "lemon" && name != "new") {
+                std::cerr << "Unknown solver: " << name << "\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+            selected.push_back(name);
+        }
+    }
+    auto isSelected = [&](const std::string& name) {
+        return std::find(selected.begin(), selected.end(), name) != selected.end();
+    };
+
+    std::cout << "\n";
+    printSeparator();
+    std::cout << "  Graph500 SSSP Kernel\n";
+    printSeparator();
+    std::cout << "\n";
+
+    // Generation is Graph500's construction step: timed, but not part of TEPS
+    std::cout << "Generating R-MAT graph (scale " << scale << ", edge factor " << edge_factor
+              << ")...\n";
+    auto start = std::chrono::steady_clock::now();
+    SimpleGraph graph = GraphGenerator::rmat(scale, edge_factor, abcd[0], abcd[1], abcd[2],
+                                             abcd[3], 0.0, 1.0, seed, threads);
+    double generation_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (pin_cpu >= 0) {
+        std::string error;
+        if (!pinToCpu(pin_cpu, error)) {
+            std::cerr << "Error pinning: " << error << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<int> roots = sampleGraph500Roots(graph, num_roots, seed);
+
+    std::cout << "\n";
+    printSeparator('-');
+    std::cout << "Graph:\n";
+    printSeparator('-');
+    std::cout << "  Vertices:     " << std::setw(15) << graph.n << "\n";
+    std::cout << "  Edges:        " << std::setw(15) << graph.m / 2 << " undirected ("
+              << graph.m << " arcs)\n";
+    std::cout << "  A, B, C, D:   " << std::setw(15) << abcd_text << "\n";
+    std::cout << "  Weights:      " << std::setw(15) << "uniform [0, 1)" << "\n";
+    std::cout << "  Generation:   " << std::setw(12) << std::fixed << std::setprecision(3)
+              << generation_s << " s\n";
+    std::cout << "  Roots:        " << std::setw(15) << roots.size() << "\n";
+    std::cout << "  Seed:         " << std::setw(15) << seed << "\n";
+    std::cout << "  CPU:          " << std::setw(15)
+              << (pin_cpu >= 0 ? "pinned to " + std::to_string(pin_cpu) : std::string("not pinned"))
+              << "\n";
+
+    if (roots.empty()) {
+        std::cerr << "No vertex with an edge to sample roots from\n";
+        return 1;
+    }
+
+    // LEMON's graph and the New SSSP solver are built once, outside the timed
+    // searches, so every solver is timed on its search alone
+    Graph lemon_graph;
+    WeightMap lemon_weights(lemon_graph);
+    std::vector<Node> lemon_nodes;
+    if (isSelected("lemon")) {
+        lemon_nodes = DijkstraLemon::buildGraph(graph, lemon_graph, lemon_weights);
+    }
+    std::unique_ptr<NewSSSP> new_solver;
+    if (isSelected("new")) new_solver = std::make_unique<NewSSSP>(graph);
+
+    std::vector<std::pair<std::string, std::function<void(int, double*, int*)>>> solves;
+    if (isSelected("dijkstra")) {
+        solves.emplace_back("Dijkstra (simple)", [&](int root, double* dist, int* pred) {
+            SimpleDijkstra::solve(graph, root, dist, pred);
+        });
+    }
+    if (isSelected("lemon")) {
+        solves.emplace_back("LEMON Dijkstra", [&](int root, double* dist, int* pred) {
+            DijkstraLemon::solve(lemon_graph, lemon_weights, lemon_nodes[root], dist, pred);
+        });
+    }
+    if (isSelected("new")) {
+        solves.emplace_back("New SSSP", [&](int root, double* dist, int* pred) {
+            new_solver->solve(root, dist, pred);
+        });
+    }
+
+    std::cout << "\n";
+    printSeparator('-');
+    std::cout << "Running " << roots.size() << " searches per solver (each validated)...\n";
+    printSeparator('-');
+
+    std::vector<SolverKernel> results;
+    for (auto& [name, solve] : solves) {
+        std::cout << "  " << std::left << std::setw(20) << name << std::right << std::flush;
+        results.push_back({name, runGraph500Kernel(graph, roots, solve, threads)});
+        const auto& kernel = results.back().kernel;
+        std::cout << kernel.validated() << " / " << kernel.searches.size() << " validated\n";
+    }
+
+    std::cout << "\n";
+    printSeparator('=');
+    std::cout << "  GRAPH500 RESULTS (solvers with every search validated)\n";
+    printSeparator('=');
+    std::cout << "\n";
+    std::cout << std::left << std::setw(20) << "Solver" << std::right
+              << std::setw(12) << "Validated" << std::setw(14) << "HMean TEPS"
+              << std::setw(12) << "Min" << std::setw(12) << "Median"
+              << std::setw(12) << "Max" << "\n";
+    printSeparator('-', 82);
+
+    bool all_valid = true;
+    for (const auto& [name, kernel] : results) {
+        auto stats = kernel.tepsStats();
+        std::ostringstream validated;
+        validated << kernel.validated() << "/" << kernel.searches.size();
+        std::cout << std::left << std::setw(20) << name << std::right
+                  << std::setw(12) << validated.str();
+        bool valid = kernel.validated() == kernel.searches.size();
+        if (!valid) {
+            std::cout << std::setw(14) << "n/a" << std::setw(12) << "n/a" << std::setw(12) << "n/a"
+                      << std::setw(12) << "n/a" << "\n";
+        } else {
+            std::cout << std::scientific << std::setprecision(3)
+                      << std::setw(14) << kernel.harmonicMeanTEPS()
+                      << std::setw(12) << stats.min << std::setw(12) << stats.median
+                      << std::setw(12) << stats.max << "\n";
+        }
+        all_valid = all_valid && valid;
+    }
+    std::cout << std::fixed;
+    std::cout << "\n  TEPS: undirected edges in the root's component / search time. Validation\n"
+              << "  (shortest-path certificate) is not timed; a solver with any failed search\n"
+              << "  gets no TEPS.\n";
+
+    if (!json_path.empty()) {
+        if (!writeJson(json_path, scale, edge_factor, abcd, seed, graph, generation_s, results)) {
+            std::cerr << "Error writing " << json_path << "\n";
+            return 1;
+        }
+        std::cout << "\n  Results written to: " << json_path << "\n";
+    }
+
+    std::cout << "\n";
+    if (!all_valid) {
+        std::cout << std::flush;
+        std::cerr << "Error: some searches failed validation\n";
+        return 1;
+    }
+    return 0;
+}
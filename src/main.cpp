@@ -1,16 +1,32 @@
 #include <iostream>
 #include <iomanip>
-#include <chrono>
 #include "new_sssp.hpp"
 #include "dijkstra_lemon.hpp"
 #include "graph_generator.hpp"
+#include "csr_graph.hpp"
+#include "solver_phases.hpp"
 
 using namespace sssp;
 
+// End-to-end time of one solve: every phase except the certificate check
+double totalTime(const PhaseTimer& phases) {
+    double total = 0;
+    for (const auto& phase : phases.names()) {
+        if (phase != "verify") total += phases.total(phase);
+    }
+    return total;
+}
+
 void printResults(const std::string& name, const std::vector<double>& distances,
-                  double time_ms, int n) {
+                  const PhaseTimer& phases, int n) {
     std::cout << "\n" << name << " Results:\n";
-    std::cout << "  Time: " << std::fixed << std::setprecision(3) << time_ms << " ms\n";
+    std::cout << "  Time: " << std::fixed << std::setprecision(3) << totalTime(phases) << " ms (";
+    const char* separator = "";
+    for (const auto& phase : phases.names()) {
+        std::cout << separator << phase << " " << phases.total(phase);
+        separator = ", ";
+    }
+    std::cout << ")\n";
 
     // Show first few distances
     std::cout << "  First 10 distances: ";
@@ -41,63 +57,69 @@ void runComparison(int n, int m, const std::string& graph_type) {
     std::cout << "Graph: " << graph_type << " (n=" << n << ", m=" << m << ")\n";
     std::cout << std::string(60, '=') << "\n";
 
-    SimpleGraph g;
-    if (graph_type == "sparse") {
-        g = GraphGenerator::randomSparse(n, m);
-    } else if (graph_type == "grid") {
-        int side = static_cast<int>(std::sqrt(n));
-        g = GraphGenerator::grid(side, side);
-    } else if (graph_type == "scalefree") {
-        g = GraphGenerator::scaleFree(n, 5, 3);
-    } else {
-        g = GraphGenerator::randomSparse(n, m);
+    PhaseTimer load;
+    SimpleGraph g = load.measure("generate", [&] {
+        if (graph_type == "sparse") {
+            return GraphGenerator::randomSparse(n, m);
+        } else if (graph_type == "grid") {
+            int side = static_cast<int>(std::sqrt(n));
+            return GraphGenerator::grid(side, side);
+        } else if (graph_type == "scalefree") {
+            return GraphGenerator::scaleFree(n, 5, 3);
+        }
+        return GraphGenerator::randomSparse(n, m);
+    });
+    // Preprocessing figure only: the solvers below run on the adjacency lists
+    PhaseTimer preprocess;
+    {
+        auto csr = preprocess.measure("csr_build", [&] { return CSRGraph(g); });
     }
 
-    std::cout << "Graph created: " << g.n << " nodes, " << g.m << " edges\n";
-
-    // Run Dijkstra
-    auto start = std::chrono::high_resolution_clock::now();
-    auto dijkstra_result = SimpleDijkstra::solve(g, 0);
-    auto end = std::chrono::high_resolution_clock::now();
-    double dijkstra_time = std::chrono::duration<double, std::milli>(end - start).count();
-    printResults("Dijkstra", dijkstra_result.distances, dijkstra_time, g.n);
-
-    // Run LEMON Dijkstra
-    start = std::chrono::high_resolution_clock::now();
-    auto lemon_result = DijkstraLemon::solve(g, 0);
-    end = std::chrono::high_resolution_clock::now();
-    double lemon_time = std::chrono::duration<double, std::milli>(end - start).count();
-    printResults("LEMON Dijkstra", lemon_result.distances, lemon_time, g.n);
-
-    // Run New SSSP
-    start = std::chrono::high_resolution_clock::now();
-    NewSSSP solver(g);
-    auto new_result = solver.solve(0);
-    end = std::chrono::high_resolution_clock::now();
-    double new_time = std::chrono::duration<double, std::milli>(end - start).count();
-    printResults("New SSSP (O(m log^{2/3} n))", new_result.distances, new_time, g.n);
+    std::cout << "Graph created: " << g.n << " nodes, " << g.m << " edges ("
+              << std::fixed << std::setprecision(3) << load.total("generate") << " ms)\n";
+    std::cout << "Preprocess: CSR build " << preprocess.total("csr_build")
+              << " ms (not solved on)\n";
+
+    // Each solver runs end to end, one phase at a time; LEMON's and New SSSP's
+    // results are certified, and Dijkstra's distances give the error figure
+    PhaseTimer dijkstra_phases, lemon_phases, new_phases;
+    auto dijkstra_result = solveSimpleDijkstraInPhases(g, 0, dijkstra_phases);
+    printResults("Dijkstra", dijkstra_result.distances, dijkstra_phases, g.n);
+
+    auto lemon_result = solveLemonInPhases(g, 0, lemon_phases, true);
+    printResults("LEMON Dijkstra", lemon_result.distances, lemon_phases, g.n);
+
+    auto new_result = solveNewSSSPInPhases(g, 0, new_phases, true);
+    printResults("New SSSP (O(m log^{2/3} n))", new_result.distances, new_phases, g.n);
 
     // Verify correctness
     std::cout << "\nVerifying correctness...\n";
-    bool correct = true;
     double max_error = 0;
     for (int i = 0; i < g.n; ++i) {
-        if (dijkstra_result.distances[i] < INF) {
-            double error = std::abs(dijkstra_result.distances[i] - new_result.distances[i]);
-            max_error = std::max(max_error, error);
-            if (error > 1e-6) {
-                correct = false;
-            }
+        if (dijkstra_result.distances[i] < INF && new_result.distances[i] < INF) {
+            max_error = std::max(max_error,
+                                 std::abs(dijkstra_result.distances[i] - new_result.distances[i]));
         }
     }
-    std::cout << "  Correctness: " << (correct ? "PASSED" : "FAILED") << "\n";
+    const CertificateCheck& check = new_result.certificate;
+    std::cout << "  Correctness: " << (check.valid() ? "PASSED" : "FAILED") << "\n";
+    std::cout << "  Violated edges: " << check.violated_edges << ", untight vertices: "
+              << check.untight_vertices << " (LEMON certified: "
+              << (lemon_result.certificate.valid() ? "yes" : "no") << ")\n";
     std::cout << "  Max error: " << std::scientific << max_error << "\n";
-
-    // Speedup
-    std::cout << "\nPerformance comparison:\n";
+    std::cout << "  Verify time: " << std::fixed << std::setprecision(3)
+              << new_phases.total("verify") << " ms\n";
+
+    // Speedup, for the search alone and end to end
+    double dijkstra_solve = dijkstra_phases.total("solve");
+    double lemon_solve = lemon_phases.total("solve");
+    double new_solve = new_phases.total("solve");
+    std::cout << "\nPerformance comparison (solve / end to end):\n";
     std::cout << "  Dijkstra/New ratio: " << std::fixed << std::setprecision(2)
-              << dijkstra_time / new_time << "x\n";
-    std::cout << "  LEMON/New ratio: " << lemon_time / new_time << "x\n";
+              << dijkstra_solve / new_solve << "x / "
+              << totalTime(dijkstra_phases) / totalTime(new_phases) << "x\n";
+    std::cout << "  LEMON/New ratio: " << lemon_solve / new_solve << "x / "
+              << totalTime(lemon_phases) / totalTime(new_phases) << "x\n";
 }
 
 int main(int argc, char* argv[]) {
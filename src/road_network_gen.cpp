@@ -0,0 +1,139 @@
+/**
+ * Road Network Generator
+ *
+ * Streams a synthetic road network (road_network.hpp) to a Matrix Market
+ * file for sssp_benchmark, or to a binary graph file for MappedGraph,
+ * with memory independent of its size.
+ *
+ * Usage: ./road_network_gen <rows> <cols> <output.mtx|output.csr> [options]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+
+#include "road_network.hpp"
+
+using namespace sssp;
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " <rows> <cols> <output> [options]\n";
+    std::cerr << "\n";
+    std::cerr << "Arguments:\n";
+    std::cerr << "  rows, cols   Grid of intersections (rows x cols vertices)\n";
+    std::cerr << "  output       .mtx for Matrix Market, anything else for a binary graph file\n";
+    std::cerr << "\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --seed <n>           Generator seed (default: 42)\n";
+    std::cerr << "  --arterial <k>       Arterial every k rows and columns (default: 8)\n";
+    std::cerr << "  --highway <k>        Highway every k rows and columns (default: 64)\n";
+    std::cerr << "  --threads <n>        Generator threads (default: all)\n";
+    std::cerr << "  --coordinates <file> Also write \"vertex x y\" lines (1-based vertices)\n";
+    std::cerr << "\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  " << program << " 1000 1000 roads_1m.mtx\n";
+    std::cerr << "  " << program << " 6000 6000 roads_36m.csr --coordinates roads_36m.xy\n";
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool writeCoordinates(const RoadNetwork& roads, const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    std::string text;
+    char line[64];
+    for (int v = 0; v < roads.vertices(); ++v) {
+        auto [x, y] = roads.coordinates(v);
+        int length = std::snprintf(line, sizeof(line), "%d %.6f %.6f\n", v + 1, x, y);
+        text.append(line, static_cast<size_t>(length));
+        if (text.size() >= (1 << 20)) {
+            out << text;
+            text.clear();
+        }
+    }
+    out << text;
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char* argv[]) {
+    // Options may appear anywhere; the rest are positional
+    std::vector<std::string> positional;
+    std::string coordinates_path;
+    RoadNetworkOptions options;
+    int threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool takes_value = arg == "--seed" || arg == "--arterial" || arg == "--highway" ||
+                           arg == "--threads" || arg == "--coordinates";
+        if (takes_value) {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            const char* value = argv[++i];
+            if (arg == "--seed") {
+                options.seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            } else if (arg == "--arterial") {
+                options.arterial_spacing = std::atoi(value);
+            } else if (arg == "--highway") {
+                options.highway_spacing = std::atoi(value);
+            } else if (arg == "--threads") {
+                threads = std::max(0, std::atoi(value));
+            } else {
+                coordinates_path = value;
+            }
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    options.rows = std::atoi(positional[0].c_str());
+    options.cols = std::atoi(positional[1].c_str());
+    const std::string& output = positional[2];
+
+    try {
+        RoadNetwork roads(options);
+        std::cout << "Generating " << options.rows << "x" << options.cols << " road network ("
+                  << roads.vertices() << " vertices) into " << output << "...\n";
+
+        auto start = std::chrono::steady_clock::now();
+        if (endsWith(output, ".mtx")) {
+            roads.writeMTX(output, threads);
+        } else {
+            roads.writeGraphFile(output, "", threads);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  Written in " << std::fixed << std::setprecision(2) << seconds << " s\n";
+
+        if (!coordinates_path.empty()) {
+            if (!writeCoordinates(roads, coordinates_path)) {
+                std::cerr << "Error: cannot write " << coordinates_path << "\n";
+                return 1;
+            }
+            std::cout << "  Coordinates in " << coordinates_path << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -4,7 +4,7 @@
  * Compares the new O(m log^{2/3} n) algorithm with LEMON's Dijkstra
  * on graphs loaded from MTX files.
  *
- * Usage: ./sssp_benchmark <path_to_mtx_file> [num_runs] [source_node]
+ * Usage: ./sssp_benchmark <path_to_mtx_file> [num_runs] [source_node] [options]
  */
 
 #include <iostream>
@@ -14,61 +14,302 @@
 #include <numeric>
 #include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <functional>
+#include <random>
 
 #include "mtx_parser.hpp"
 #include "new_sssp.hpp"
 #include "dijkstra_lemon.hpp"
+#include "csr_graph.hpp"
+#include "solver_phases.hpp"
+#include "shortest_path_certificate.hpp"
+#include "json_writer.hpp"
+#include "benchmark_stats.hpp"
+#include "benchmark_report.hpp"
+#include "trace_recorder.hpp"
+#include "benchmark_env.hpp"
+#include "source_sampler.hpp"
+#include "perf_counters.hpp"
+#include "memory_tracker.hpp"
+// The counting allocator puts a header on every block, timed runs included,
+// so it is only linked into builds that ask for memory accounting
+#ifdef SSSP_ENABLE_MEMORY_TRACKING
+#include "counting_allocator.hpp"
+#endif
 
 using namespace sssp;
 
-// Statistics helper
-struct BenchmarkStats {
-    double mean;
-    double median;
-    double std_dev;
-    double min;
-    double max;
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " <mtx_file> [num_runs] [source_node] [options]\n";
+    std::cerr << "\n";
+    std::cerr << "Arguments:\n";
+    std::cerr << "  mtx_file     Path to Matrix Market (.mtx) graph file\n";
+    std::cerr << "  num_runs     Number of benchmark runs (default: 5)\n";
+    std::cerr << "  source_node  Source node for SSSP (default: 0)\n";
+    std::cerr << "\n";
+    std::cerr << "Options:\n";
+    std::cerr << "  --stats-json <file>  Write the per-level BMSSP statistics as JSON\n";
+    std::cerr << "  --trace <file>       Write a Chrome trace (Perfetto) of loading, warmup and\n";
+    std::cerr << "                       one extra run of each solver\n";
+    std::cerr << "  --json <file>        Write every per-run time, counter and memory figure as JSON\n";
+    std::cerr << "  --csv <file>         Write one row per algorithm and run as CSV\n";
+    std::cerr << "  --compare <file>     Compare against a baseline written by --json; exits with 2\n";
+    std::cerr << "                       on a significant slowdown, 1 if it is from another\n";
+    std::cerr << "                       graph or source\n";
+    std::cerr << "  --threshold <pct>    Slowdown tolerated by --compare (default: 5)\n";
+    std::cerr << "  --warmup <n>         Untimed rounds of every solver before timing (default: 1)\n";
+    std::cerr << "  --pin <cpu>          Pin the benchmark to one CPU\n";
+    std::cerr << "  --cold               Flush the caches before every timed solve\n";
+    std::cerr << "  --fixed-order        Run the algorithms in a fixed order instead of shuffling\n";
+    std::cerr << "                       them every run\n";
+    std::cerr << "  --seed <n>           Seed of the shuffled order and source sample (default: 67)\n";
+    std::cerr << "  --sources <n>        Time every algorithm from n sources sampled from the\n";
+    std::cerr << "                       largest strongly connected component (replaces source_node)\n";
+    std::cerr << "  --sampling <mode>    uniform or degree (out-degree weighted; default: uniform)\n";
+    std::cerr << "\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  " << program << " /path/to/graph.mtx 10 0 --stats-json levels.json\n";
+    std::cerr << "  " << program << " /path/to/graph.mtx 20 0 --compare baseline.json\n";
+    std::cerr << "  " << program << " /path/to/graph.mtx 30 0 --pin 2 --warmup 3 --cold\n";
+    std::cerr << "  " << program << " /path/to/graph.mtx 5 --sources 64 --sampling degree\n";
+}
 
-    static BenchmarkStats compute(std::vector<double>& times) {
-        BenchmarkStats stats;
+void printSeparator(char c = '=', int width = 70) {
+    std::cout << std::string(width, c) << "\n";
+}
 
-        if (times.empty()) {
-            return {0, 0, 0, 0, 0};
+// Mean of each counter over the runs; an event is valid only if every run measured it
+PerfCounters::Sample meanSample(const std::vector<PerfCounters::Sample>& samples) {
+    PerfCounters::Sample mean;
+    if (samples.empty()) return mean;
+    mean.valid.fill(true);
+    for (const auto& sample : samples) {
+        for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+            mean.values[e] += sample.values[e] / samples.size();
+            mean.valid[e] = mean.valid[e] && sample.valid[e];
         }
+    }
+    return mean;
+}
+
+// Adds one run's counts to a running total; an event stays valid only if every run measured it
+void addSample(PerfCounters::Sample& total, const PerfCounters::Sample& sample) {
+    for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+        total.values[e] += sample.values[e];
+        total.valid[e] = total.valid[e] && sample.valid[e];
+    }
+}
+
+// One row of counts divided by `per` (edges or vertices), "n/a" where not measured
+void printCounterRow(const std::string& name, const PerfCounters::Sample& sample, double per) {
+    std::cout << std::left << std::setw(20) << name << std::right;
+    for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+        auto event = static_cast<PerfCounters::Event>(e);
+        std::cout << std::setw(14);
+        if (sample.has(event)) {
+            std::cout << std::fixed << std::setprecision(3) << sample[event] / per;
+        } else {
+            std::cout << "n/a";
+        }
+    }
+    if (sample.has(PerfCounters::Cycles) && sample.has(PerfCounters::Instructions) &&
+        sample[PerfCounters::Cycles] > 0) {
+        std::cout << std::setw(8) << std::setprecision(2)
+                  << sample[PerfCounters::Instructions] / sample[PerfCounters::Cycles];
+    }
+    std::cout << "\n";
+}
+
+void printCounterTable(const char* title, double per,
+                       const std::vector<std::pair<std::string, PerfCounters::Sample>>& rows) {
+    std::cout << "\n  " << title << ":\n";
+    std::cout << std::left << std::setw(20) << "Algorithm" << std::right;
+    for (int e = 0; e < PerfCounters::NumEvents; ++e) {
+        std::cout << std::setw(14) << PerfCounters::name(static_cast<PerfCounters::Event>(e));
+    }
+    std::cout << std::setw(8) << "IPC" << "\n";
+    printSeparator('-', 98);
+    for (const auto& [name, sample] : rows) {
+        printCounterRow(name, sample, per);
+    }
+}
 
-        std::sort(times.begin(), times.end());
+double toMB(double bytes) { return bytes / (1024.0 * 1024.0); }
 
-        stats.min = times.front();
-        stats.max = times.back();
-        stats.median = times[times.size() / 2];
+// Usage of one untimed run of `run`, with allocation counting on
+template <typename F>
+MemoryUsage measureMemory(F&& run) {
+    MemoryTracker::enable(true);
+    MemoryRun measured;
+    run();
+    MemoryUsage usage = measured.finish();
+    MemoryTracker::enable(false);
+    return usage;
+}
 
-        double sum = std::accumulate(times.begin(), times.end(), 0.0);
-        stats.mean = sum / times.size();
+void printMemoryTable(const std::vector<std::pair<std::string, MemoryUsage>>& rows) {
+    std::cout << std::left << std::setw(20) << "Algorithm" << std::right
+              << std::setw(14) << "Alloc (MB)" << std::setw(12) << "Allocs"
+              << std::setw(14) << "Peak (MB)" << std::setw(14) << "Peak RSS" << "\n";
+    printSeparator('-');
+    for (const auto& [name, usage] : rows) {
+        std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+                  << std::setprecision(2)
+                  << std::setw(14) << toMB(usage.total.allocated_bytes)
+                  << std::setw(12) << usage.total.allocations
+                  << std::setw(14) << toMB(usage.total.peak_live_bytes)
+                  << std::setw(11) << toMB(usage.peak_rss_bytes) << " MB"
+                  << (usage.peak_rss_reset ? "" : "*") << "\n";
+    }
 
-        double sq_sum = 0;
-        for (double t : times) {
-            sq_sum += (t - stats.mean) * (t - stats.mean);
+    std::cout << "\n  Peak live MB by category (allocations):\n";
+    std::cout << std::left << std::setw(20) << "Algorithm" << std::right;
+    for (int c = 1; c < num_memory_categories; ++c) {
+        std::cout << std::setw(20) << memoryCategoryName(static_cast<MemoryCategory>(c));
+    }
+    std::cout << "\n";
+    printSeparator('-', 100);
+    for (const auto& [name, usage] : rows) {
+        std::cout << std::left << std::setw(20) << name << std::right;
+        for (int c = 1; c < num_memory_categories; ++c) {
+            const auto& counters = usage.categories[c];
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(2) << toMB(counters.peak_live_bytes)
+                 << " (" << counters.allocations << ")";
+            std::cout << std::setw(20) << cell.str();
         }
-        stats.std_dev = std::sqrt(sq_sum / times.size());
+        std::cout << "\n";
+    }
+}
 
-        return stats;
+// Time spent in level l itself: inclusive time minus that of level l - 1
+double selfTime(const std::vector<LevelStats>& levels, size_t l) {
+    return levels[l].time_ms - (l > 0 ? levels[l - 1].time_ms : 0.0);
+}
+
+void printLevelStats(const std::vector<LevelStats>& levels) {
+    std::cout << std::right
+              << std::setw(5) << "Level" << std::setw(8) << "Calls"
+              << std::setw(9) << "Pulls" << std::setw(10) << "Inserts"
+              << std::setw(10) << "Prepend" << std::setw(10) << "Avg |U|"
+              << std::setw(9) << "Max |U|" << std::setw(8) << "Rounds"
+              << std::setw(8) << "Pivots" << std::setw(7) << "Early"
+              << std::setw(8) << "Partial" << std::setw(12) << "Relax"
+              << std::setw(11) << "Incl (ms)" << std::setw(11) << "Self (ms)" << "\n";
+    printSeparator('-', 126);
+
+    for (size_t l = levels.size(); l-- > 0;) {
+        const auto& s = levels[l];
+        double avg_u = s.calls > 0 ? static_cast<double>(s.u_total) / s.calls : 0.0;
+        std::cout << std::setw(5) << s.level << std::setw(8) << s.calls
+                  << std::setw(9) << s.pulls << std::setw(10) << s.inserts
+                  << std::setw(10) << s.prepended
+                  << std::setw(10) << std::fixed << std::setprecision(1) << avg_u
+                  << std::setw(9) << s.u_max << std::setw(8) << s.pivot_rounds
+                  << std::setw(8) << s.pivots << std::setw(7) << s.pivot_early_exits
+                  << std::setw(8) << s.partial_executions << std::setw(12) << s.relaxations
+                  << std::setprecision(2)
+                  << std::setw(11) << s.time_ms << std::setw(11) << selfTime(levels, l) << "\n";
     }
-};
+}
 
-void printUsage(const char* program) {
-    std::cerr << "Usage: " << program << " <mtx_file> [num_runs] [source_node]\n";
-    std::cerr << "\n";
-    std::cerr << "Arguments:\n";
-    std::cerr << "  mtx_file     Path to Matrix Market (.mtx) graph file\n";
-    std::cerr << "  num_runs     Number of benchmark runs (default: 5)\n";
-    std::cerr << "  source_node  Source node for SSSP (default: 0)\n";
-    std::cerr << "\n";
-    std::cerr << "Example:\n";
-    std::cerr << "  " << program << " /path/to/graph.mtx 10 0\n";
+bool writeLevelStatsJson(const std::string& path, const std::string& graph_path,
+                         const SimpleGraph& graph, int source,
+                         const BasicNewSSSP<ProfilingPolicy>& solver) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    JsonWriter json(out);
+    json.beginObject();
+    json.key("graph").value(graph_path);
+    json.key("n").value(graph.n);
+    json.key("m").value(graph.m);
+    json.key("source").value(source);
+    json.key("k").value(solver.getK());
+    json.key("t").value(solver.getT());
+    json.key("max_level").value(solver.getMaxLevel());
+    json.key("relaxations").value(solver.getRelaxationCount());
+
+    const auto& levels = solver.getLevelStats();
+    json.key("levels").beginArray();
+    for (size_t l = 0; l < levels.size(); ++l) {
+        const auto& s = levels[l];
+        json.beginObject();
+        json.key("level").value(s.level);
+        json.key("calls").value(s.calls);
+        json.key("pulls").value(s.pulls);
+        json.key("inserts").value(s.inserts);
+        json.key("prepended").value(s.prepended);
+        json.key("u_total").value(s.u_total);
+        json.key("u_max").value(s.u_max);
+        json.key("pivot_rounds").value(s.pivot_rounds);
+        json.key("pivots").value(s.pivots);
+        json.key("pivot_early_exits").value(s.pivot_early_exits);
+        json.key("partial_executions").value(s.partial_executions);
+        json.key("relaxations").value(s.relaxations);
+        json.key("time_ms").value(s.time_ms);
+        json.key("self_time_ms").value(selfTime(levels, l));
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    out << "\n";
+    return static_cast<bool>(out);
 }
 
-void printSeparator(char c = '=', int width = 70) {
-    std::cout << std::string(width, c) << "\n";
+// Min, quartiles and max of one per-source quantity
+void printDistributionRow(const std::string& name, const std::vector<double>& values,
+                          int precision) {
+    auto stats = BenchmarkStats::compute(values);
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+              << std::setprecision(precision)
+              << std::setw(12) << stats.min << std::setw(12) << stats.q1
+              << std::setw(12) << stats.median << std::setw(12) << stats.q3
+              << std::setw(12) << stats.max << "\n";
+}
+
+// Writes the report with `write` (JSON or CSV); false if the file cannot be written
+template <typename Writer>
+bool writeReportFile(const std::string& path, const BenchmarkReport& report, Writer&& write) {
+    std::ofstream out(path);
+    if (!out) return false;
+    write(report, out);
+    return static_cast<bool>(out);
+}
+
+// Prints one row per algorithm; returns true if any of them regressed
+bool printComparison(const std::vector<BaselineComparison>& rows, double threshold) {
+    std::ios saved_format(nullptr);
+    saved_format.copyfmt(std::cout);
+
+    std::cout << std::left << std::setw(20) << "Algorithm" << std::right
+              << std::setw(14) << "Baseline" << std::setw(12) << "Current"
+              << std::setw(10) << "Delta" << std::setw(22) << "95% CI" << "  Verdict\n";
+    printSeparator('-', 90);
+
+    bool regressed = false;
+    for (const auto& row : rows) {
+        std::ostringstream ci;
+        ci << std::showpos << std::fixed << std::setprecision(1)
+           << (row.ratio.low - 1) * 100 << "% .. " << (row.ratio.high - 1) * 100 << "%";
+        const char* verdict = row.regression ? "SLOWER" : row.improvement ? "faster" : "same";
+        std::cout << std::left << std::setw(20) << row.name << std::right << std::fixed
+                  << std::setprecision(2)
+                  << std::setw(11) << row.baseline_median << " ms"
+                  << std::setw(9) << row.current_median << " ms"
+                  << std::setw(9) << std::showpos << std::setprecision(1)
+                  << (row.ratio.ratio - 1) * 100 << "%" << std::noshowpos
+                  << std::setw(22) << ci.str() << "  " << verdict << "\n";
+        regressed = regressed || row.regression;
+    }
+    std::cout << "\n  Threshold: " << std::setprecision(1) << threshold * 100
+              << "% (a slowdown counts when its whole interval lies above it)\n";
+    std::cout.copyfmt(saved_format);
+    return regressed;
 }
 
 int main(int argc, char* argv[]) {
@@ -77,12 +318,113 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    std::string mtx_path = argv[1];
-    int num_runs = (argc > 2) ? std::atoi(argv[2]) : 5;
-    int source = (argc > 3) ? std::atoi(argv[3]) : 0;
+    // Options may appear anywhere; the rest are positional
+    std::vector<std::string> positional;
+    std::string stats_json_path;
+    std::string trace_path;
+    std::string json_path;
+    std::string csv_path;
+    std::string compare_path;
+    double threshold = 0.05;
+    int warmups = 1;
+    int pin_cpu = -1;
+    bool cold_cache = false;
+    bool shuffle = true;
+    uint32_t seed = 67;
+    int num_sources = 0;
+    std::string sampling_name = "uniform";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string* text_option = arg == "--stats-json" ? &stats_json_path
+                                 : arg == "--trace"      ? &trace_path
+                                 : arg == "--json"       ? &json_path
+                                 : arg == "--csv"        ? &csv_path
+                                 : arg == "--compare"    ? &compare_path
+                                 : arg == "--sampling"   ? &sampling_name
+                                                         : nullptr;
+        bool number_option = arg == "--threshold" || arg == "--warmup" || arg == "--pin" ||
+                             arg == "--seed" || arg == "--sources";
+        if (text_option || number_option) {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            const char* value = argv[++i];
+            if (text_option) {
+                *text_option = value;
+            } else if (arg == "--threshold") {
+                threshold = std::atof(value) / 100.0;
+            } else if (arg == "--warmup") {
+                warmups = std::max(0, std::atoi(value));
+            } else if (arg == "--pin") {
+                pin_cpu = std::atoi(value);
+            } else if (arg == "--sources") {
+                num_sources = std::max(0, std::atoi(value));
+            } else {
+                seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            }
+        } else if (arg == "--cold") {
+            cold_cache = true;
+        } else if (arg == "--fixed-order") {
+            shuffle = false;
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string mtx_path = positional[0];
+    int num_runs = (positional.size() > 1) ? std::atoi(positional[1].c_str()) : 5;
+    int source = (positional.size() > 2) ? std::atoi(positional[2].c_str()) : 0;
 
     if (num_runs < 1) num_runs = 1;
 
+    if (sampling_name != "uniform" && sampling_name != "degree") {
+        std::cerr << "Unknown sampling mode: " << sampling_name << "\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+    SourceSampling sampling =
+        sampling_name == "degree" ? SourceSampling::Degree : SourceSampling::Uniform;
+
+    // Read the baseline before any work, so a bad file fails fast
+    BenchmarkReport baseline;
+    if (!compare_path.empty()) {
+        try {
+            baseline = readJsonReport(compare_path);
+        } catch (const std::exception& e) {
+            std::cerr << "Error reading baseline: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    // Pin before loading, so the graph is first touched from the measuring CPU
+    if (pin_cpu >= 0) {
+        std::string error;
+        if (!pinToCpu(pin_cpu, error)) {
+            std::cerr << "Error pinning: " << error << "\n";
+            return 1;
+        }
+    }
+
+    // The timed runs are never recorded, so tracing does not skew them
+    std::unique_ptr<TraceRecorder> recorder;
+    if (!trace_path.empty()) {
+#ifndef SSSP_ENABLE_TRACING
+        std::cerr << "Warning: built without SSSP_ENABLE_TRACING; the trace will be empty\n";
+#endif
+        recorder = std::make_unique<TraceRecorder>();
+        recorder->start();
+    }
+
     // Print header
     std::cout << "\n";
     printSeparator();
@@ -96,21 +438,34 @@ int main(int argc, char* argv[]) {
     SimpleGraph graph;
     MTXParser::GraphInfo info;
 
+    // Load phases; parsing runs with allocation counting on, which adds a little
+    PhaseTimer load_phases;
+    MemoryUsage load_memory;
     try {
-        auto result = MTXParser::parse(mtx_path);
-        graph = std::move(result.first);
-        info = result.second;
+        load_memory = measureMemory([&] {
+            auto result = load_phases.measure("parse", [&] { return MTXParser::parse(mtx_path); });
+            graph = std::move(result.first);
+            info = result.second;
+        });
     } catch (const std::exception& e) {
+        MemoryTracker::enable(false);
         std::cerr << "Error loading graph: " << e.what() << "\n";
         return 1;
     }
 
-    // Validate source
-    if (source < 0 || source >= graph.n) {
+    // Validate source (ignored when sources are sampled)
+    if (num_sources == 0 && (source < 0 || source >= graph.n)) {
         std::cerr << "Invalid source node: " << source << " (graph has " << graph.n << " nodes)\n";
         return 1;
     }
 
+    // Preprocessing, reported apart from loading: the solves below run on the
+    // adjacency lists, so this is the up-front cost of switching to CSRGraph
+    PhaseTimer preprocess;
+    {
+        auto csr = preprocess.measure("csr_build", [&] { return CSRGraph(graph); });
+    }
+
     // Print graph info
     std::cout << "\n";
     printSeparator('-');
@@ -123,8 +478,60 @@ int main(int argc, char* argv[]) {
     std::cout << "  Avg degree:   " << std::setw(15) << std::setprecision(2)
               << (double)graph.m / graph.n << "\n";
     std::cout << "  Type:         " << std::setw(15) << (info.is_directed ? "Directed" : "Undirected") << "\n";
-    std::cout << "  Source node:  " << std::setw(15) << source << "\n";
+    std::cout << "  Parse:        " << std::setw(12) << load_phases.median("parse") << " ms\n";
+    std::cout << "  CSR build:    " << std::setw(12) << preprocess.median("csr_build")
+              << " ms (preprocess, not solved on)\n";
+    if (num_sources > 0) {
+        std::cout << "  Sources:      " << std::setw(15)
+                  << std::to_string(num_sources) + " " + sampling_name << "\n";
+    } else {
+        std::cout << "  Source node:  " << std::setw(15) << source << "\n";
+    }
     std::cout << "  Benchmark runs:" << std::setw(14) << num_runs << "\n";
+    std::cout << "  Warmup rounds:" << std::setw(15) << warmups << "\n";
+    std::cout << "  Order:        " << std::setw(15) << (shuffle ? "shuffled" : "fixed") << "\n";
+    if (shuffle || num_sources > 0) std::cout << "  Seed:         " << std::setw(15) << seed << "\n";
+    std::cout << "  Cache:        " << std::setw(15) << (cold_cache ? "cold" : "warm") << "\n";
+    std::cout << "  CPU:          " << std::setw(15)
+              << (pin_cpu >= 0 ? "pinned to " + std::to_string(pin_cpu) : std::string("not pinned"))
+              << "\n";
+
+    // Every timed run solves from each of these; the single-source sections use the first
+    std::vector<int> run_sources = {source};
+    std::vector<int> reached;        // Vertices reached from each source
+    std::vector<double> reached_edges;  // Out-edges of those vertices (edges a search scans)
+    if (num_sources > 0) {
+        std::cout << "\n";
+        printSeparator('-');
+        std::cout << "Source Sampling:\n";
+        printSeparator('-');
+
+        auto region = largestStronglyConnectedComponent(graph);
+        run_sources = sampleSources(graph, region, num_sources, sampling, seed);
+        source = run_sources.front();
+        std::cout << "  Largest SCC:  " << std::setw(15) << region.size() << " vertices ("
+                  << std::fixed << std::setprecision(1) << 100.0 * region.size() / graph.n
+                  << "%)\n";
+        std::cout << "  Sampled:      " << std::setw(15) << run_sources.size() << " distinct sources\n";
+        std::cout << "  First source: " << std::setw(15) << source
+                  << " (used by the memory, level and trace runs)\n";
+
+        std::vector<double> distances(graph.n);
+        std::vector<int> predecessors(graph.n);
+        for (int s : run_sources) {
+            SimpleDijkstra::solve(graph, s, distances, predecessors);
+            int count = 0;
+            double edges = 0;
+            for (int v = 0; v < graph.n; ++v) {
+                if (distances[v] < INF) {
+                    count++;
+                    edges += graph.outEdges(v).size();
+                }
+            }
+            reached.push_back(count);
+            reached_edges.push_back(edges);
+        }
+    }
 
     // Theoretical complexity comparison
     double n = graph.n;
@@ -143,6 +550,30 @@ int main(int argc, char* argv[]) {
     std::cout << "  Ratio:        " << std::fixed << std::setprecision(3)
               << dijkstra_complexity / new_complexity << "x (theoretical)\n";
 
+    // Output buffers reused across runs, so no n-sized result vectors are
+    // allocated or copied inside the timed region
+    std::vector<double> dist_buffer(graph.n);
+    std::vector<int> pred_buffer(graph.n);
+
+    // LEMON returns a fresh result; it is released outside the timed region
+    PhasedSolve lemon_result;
+
+    // Timed solvers; the report keeps every run of each, in run order. Each
+    // also times its phases into the given PhaseTimer, which is where the
+    // phase breakdown comes from.
+    enum { SimpleIndex, LemonIndex, NewIndex };
+    std::vector<std::function<void(int, PhaseTimer&)>> solves = {
+        [&](int s, PhaseTimer& phases) {
+            phases.measure("solve", [&] { SimpleDijkstra::solve(graph, s, dist_buffer, pred_buffer); });
+        },
+        [&](int s, PhaseTimer& phases) { lemon_result = solveLemonInPhases(graph, s, phases); },
+        [&](int s, PhaseTimer& phases) {
+            auto solver = phases.measure("setup", [&] { return std::make_unique<NewSSSP>(graph); });
+            phases.measure("solve", [&] { solver->solve(s, dist_buffer, pred_buffer); });
+        },
+    };
+    std::vector<PhaseTimer> phase_timers(solves.size());
+
     // Warmup run
     std::cout << "\n";
     printSeparator('-');
@@ -150,43 +581,50 @@ int main(int argc, char* argv[]) {
     printSeparator('-');
 
     {
-        auto dijkstra_result = DijkstraLemon::solve(graph, source);
+        // New SSSP's result from every source is checked as a shortest-path
+        // certificate (O(m), no reference run); see shortest_path_certificate.hpp
+        CertificateCheck total;
+        total.source_ok = true;
+        size_t certified = 0;
         NewSSSP solver(graph);
-        auto new_result = solver.solve(source);
-
-        // Verify correctness
-        int mismatches = 0;
-        double max_error = 0;
-        int dijkstra_reachable = 0;
-        int new_reachable = 0;
-
-        for (int i = 0; i < graph.n; ++i) {
-            if (dijkstra_result.distances[i] < INF) {
-                dijkstra_reachable++;
-                if (new_result.distances[i] < INF) {
-                    double error = std::abs(dijkstra_result.distances[i] - new_result.distances[i]);
-                    max_error = std::max(max_error, error);
-                    if (error > 1e-6) {
-                        mismatches++;
-                    }
-                } else {
-                    mismatches++;
-                }
-            }
-            if (new_result.distances[i] < INF) {
-                new_reachable++;
-            }
+        for (int s : run_sources) {
+            solver.solve(s, dist_buffer, pred_buffer);
+            CertificateCheck check = phase_timers[NewIndex].measure("verify", [&] {
+                return verifyShortestPaths(graph, s, dist_buffer, pred_buffer);
+            });
+
+            if (s == source) total.reached = check.reached;
+            total.source_ok = total.source_ok && check.source_ok;
+            total.violated_edges += check.violated_edges;
+            total.untight_vertices += check.untight_vertices;
+            total.unrooted_vertices += check.unrooted_vertices;
+            if (check.valid()) certified++;
         }
 
-        std::cout << "  Dijkstra reachable: " << dijkstra_reachable << " / " << graph.n << "\n";
-        std::cout << "  New SSSP reachable: " << new_reachable << " / " << graph.n << "\n";
-        std::cout << "  Max error:          " << std::scientific << max_error << "\n";
-        std::cout << "  Correctness:        " << (mismatches == 0 ? "PASSED" : "FAILED") << "\n";
+        std::cout << "  New SSSP reachable: " << total.reached << " / " << graph.n << "\n";
+        std::cout << "  Violated edges:     " << total.violated_edges << "\n";
+        std::cout << "  Untight vertices:   " << total.untight_vertices << "\n";
+        std::cout << "  Unrooted vertices:  " << total.unrooted_vertices << "\n";
+        std::cout << "  Certified sources:  " << certified << " / " << run_sources.size()
+                  << " (" << std::fixed << std::setprecision(2) << phase_timers[NewIndex].total("verify") << " ms)\n";
+        std::cout << "  Correctness:        " << (total.valid() ? "PASSED" : "FAILED") << "\n";
+
+        if (!total.valid()) {
+            std::cerr << "  WARNING: " << run_sources.size() - certified
+                      << " source(s) failed the shortest-path certificate!\n";
+        }
+    }
 
-        if (mismatches > 0) {
-            std::cerr << "  WARNING: " << mismatches << " distance mismatches detected!\n";
+    // Warmup rounds run the exact timed code paths, buffers included
+    for (int w = 0; w < warmups; ++w) {
+        PhaseTimer discarded;
+        for (auto& solve : solves) {
+            for (int s : run_sources) solve(s, discarded);
         }
     }
+    std::cout << "  Warmup rounds:      " << warmups << "\n";
+
+    if (recorder) recorder->stop();
 
     // Benchmark runs
     std::cout << "\n";
@@ -194,44 +632,114 @@ int main(int argc, char* argv[]) {
     std::cout << "Running benchmark (" << num_runs << " iterations)...\n";
     printSeparator('-');
 
-    std::vector<double> dijkstra_times;
-    std::vector<double> lemon_times;
-    std::vector<double> new_times;
+    BenchmarkReport report;
+    report.graph_path = mtx_path;
+    report.n = graph.n;
+    report.m = graph.m;
+    report.directed = info.is_directed;
+    report.fingerprint = graphFingerprint(graph);
+    report.source = source;
+    report.warmups = warmups;
+    report.shuffled = shuffle;
+    report.seed = seed;
+    report.cold_cache = cold_cache;
+    report.pinned_cpu = pin_cpu;
+    if (num_sources > 0) {
+        report.sources = run_sources;
+        report.reached = reached;
+        report.sampling = sampling_name;
+    }
+
+    // Times from another graph or source set say nothing about a regression,
+    // so refuse to compare them rather than gate on them
+    if (!compare_path.empty()) {
+        if (baseline.fingerprint != report.fingerprint) {
+            std::cerr << "Error: baseline " << compare_path << " was measured on a different graph ("
+                      << baseline.graph_path << ", " << baseline.n << " nodes, " << baseline.m
+                      << " edges)\n";
+            return 1;
+        }
+        if (baseline.sources != report.sources) {
+            std::cerr << "Error: baseline " << compare_path << " used "
+                      << (baseline.sources.empty() ? "a single source" : "different sources")
+                      << "\n";
+            return 1;
+        }
+        if (baseline.source != report.source) {
+            std::cerr << "Error: baseline " << compare_path << " used source " << baseline.source
+                      << "\n";
+            return 1;
+        }
+    }
+    report.algorithms.resize(solves.size());
+    report.algorithms[SimpleIndex].name = "Dijkstra (simple)";
+    report.algorithms[LemonIndex].name = "LEMON Dijkstra";
+    report.algorithms[NewIndex].name = "New SSSP";
+    auto& algorithms = report.algorithms;
+
+    // Hardware counters around each timed solve (enabled outside the timed interval)
+    PerfCounters counters;
+
+    // A fresh random order every run, so no algorithm always inherits the
+    // caches, branch predictors and clock state of the same predecessor
+    std::mt19937 order_rng(seed);
+    std::vector<size_t> order(solves.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::unique_ptr<CacheFlusher> flusher;
+    if (cold_cache) {
+        flusher = std::make_unique<CacheFlusher>();
+        std::cout << "  Flushing " << std::fixed << std::setprecision(1)
+                  << toMB(flusher->bytes()) << " MB before every timed solve\n";
+    }
+
+    // Multi-source: time of every (algorithm, source) in every run
+    std::vector<std::vector<std::vector<double>>> source_times(
+        solves.size(), std::vector<std::vector<double>>(run_sources.size()));
 
     for (int run = 0; run < num_runs; ++run) {
         std::cout << "  Run " << (run + 1) << "/" << num_runs << "... " << std::flush;
 
-        // Simple Dijkstra (our implementation)
-        auto start = std::chrono::high_resolution_clock::now();
-        auto dijkstra_result = SimpleDijkstra::solve(graph, source);
-        auto end = std::chrono::high_resolution_clock::now();
-        double dijkstra_ms = std::chrono::duration<double, std::milli>(end - start).count();
-        dijkstra_times.push_back(dijkstra_ms);
-
-        // LEMON Dijkstra
-        start = std::chrono::high_resolution_clock::now();
-        auto lemon_result = DijkstraLemon::solve(graph, source);
-        end = std::chrono::high_resolution_clock::now();
-        double lemon_ms = std::chrono::duration<double, std::milli>(end - start).count();
-        lemon_times.push_back(lemon_ms);
-
-        // New SSSP
-        start = std::chrono::high_resolution_clock::now();
-        NewSSSP solver(graph);
-        auto new_result = solver.solve(source);
-        end = std::chrono::high_resolution_clock::now();
-        double new_ms = std::chrono::duration<double, std::milli>(end - start).count();
-        new_times.push_back(new_ms);
+        if (shuffle) std::shuffle(order.begin(), order.end(), order_rng);
+        for (size_t a : order) {
+            // Each solve is timed on its own; the run's time is their sum
+            double run_ms = 0;
+            PerfCounters::Sample run_counts;
+            run_counts.valid.fill(true);
+            for (size_t i = 0; i < run_sources.size(); ++i) {
+                if (flusher) flusher->flush();
+                counters.start();
+                auto start = std::chrono::high_resolution_clock::now();
+                solves[a](run_sources[i], phase_timers[a]);
+                auto end = std::chrono::high_resolution_clock::now();
+                counters.stop();
+                double ms = std::chrono::duration<double, std::milli>(end - start).count();
+                run_ms += ms;
+                source_times[a][i].push_back(ms);
+                if (counters.available()) addSample(run_counts, counters.read());
+            }
+            algorithms[a].times_ms.push_back(run_ms);
+            if (counters.available()) algorithms[a].counters.push_back(run_counts);
+        }
 
-        std::cout << "Dijkstra: " << std::fixed << std::setprecision(2) << dijkstra_ms
-                  << "ms, LEMON: " << lemon_ms
-                  << "ms, New: " << new_ms << "ms\n";
+        std::cout << "Dijkstra: " << std::fixed << std::setprecision(2)
+                  << algorithms[SimpleIndex].times_ms.back()
+                  << "ms, LEMON: " << algorithms[LemonIndex].times_ms.back()
+                  << "ms, New: " << algorithms[NewIndex].times_ms.back() << "ms\n";
+    }
+
+    if (num_sources > 0) {
+        for (size_t a = 0; a < solves.size(); ++a) {
+            for (const auto& times : source_times[a]) {
+                algorithms[a].source_times_ms.push_back(median(times));
+            }
+        }
     }
 
     // Compute statistics
-    auto dijkstra_stats = BenchmarkStats::compute(dijkstra_times);
-    auto lemon_stats = BenchmarkStats::compute(lemon_times);
-    auto new_stats = BenchmarkStats::compute(new_times);
+    auto dijkstra_stats = BenchmarkStats::compute(algorithms[SimpleIndex].times_ms);
+    auto lemon_stats = BenchmarkStats::compute(algorithms[LemonIndex].times_ms);
+    auto new_stats = BenchmarkStats::compute(algorithms[NewIndex].times_ms);
 
     // Print results
     std::cout << "\n";
@@ -245,8 +753,9 @@ int main(int argc, char* argv[]) {
               << std::setw(12) << "Median"
               << std::setw(12) << "Std Dev"
               << std::setw(12) << "Min"
-              << std::setw(12) << "Max" << "\n";
-    printSeparator('-');
+              << std::setw(12) << "Max"
+              << std::setw(10) << "Outliers" << "\n";
+    printSeparator('-', 90);
 
     auto printRow = [](const std::string& name, const BenchmarkStats& stats) {
         std::cout << std::left << std::setw(20) << name
@@ -255,38 +764,242 @@ int main(int argc, char* argv[]) {
                   << std::setw(12) << stats.median
                   << std::setw(12) << stats.std_dev
                   << std::setw(12) << stats.min
-                  << std::setw(12) << stats.max << "\n";
+                  << std::setw(12) << stats.max
+                  << std::setw(10) << stats.outliers << "\n";
     };
 
     printRow("Dijkstra (simple)", dijkstra_stats);
     printRow("LEMON Dijkstra", lemon_stats);
     printRow("New SSSP", new_stats);
+    if (dijkstra_stats.outliers + lemon_stats.outliers + new_stats.outliers > 0) {
+        std::cout << "\n  Outliers: runs outside [Q1 - 1.5 IQR, Q3 + 1.5 IQR]; the medians are"
+                  << " robust to them\n";
+    }
 
-    // Speedup comparison
+    if (num_sources > 0) {
+        std::cout << "\n  Times are per run, i.e. the sum over all " << run_sources.size()
+                  << " sources\n";
+
+        std::cout << "\n";
+        printSeparator('-');
+        std::cout << "Per-Source Distribution (" << run_sources.size() << " " << sampling_name
+                  << " sources, median over runs):\n";
+        printSeparator('-');
+        std::cout << std::left << std::setw(24) << "" << std::right
+                  << std::setw(12) << "Min" << std::setw(12) << "Q1"
+                  << std::setw(12) << "Median" << std::setw(12) << "Q3"
+                  << std::setw(12) << "Max" << "\n";
+        printSeparator('-', 84);
+        printDistributionRow("Reached vertices",
+                             std::vector<double>(reached.begin(), reached.end()), 0);
+        for (const auto& algorithm : algorithms) {
+            printDistributionRow(algorithm.name + " (ms)", algorithm.source_times_ms, 3);
+        }
+
+        // Throughput over all sources, from the per-source medians
+        double total_edges = std::accumulate(reached_edges.begin(), reached_edges.end(), 0.0);
+        double total_vertices = std::accumulate(reached.begin(), reached.end(), 0.0);
+        std::cout << "\n" << std::left << std::setw(24) << "Throughput" << std::right
+                  << std::setw(12) << "Sources/s" << std::setw(12) << "MTEPS"
+                  << std::setw(16) << "M vertices/s" << "\n";
+        printSeparator('-', 84);
+        for (const auto& algorithm : algorithms) {
+            double seconds = std::accumulate(algorithm.source_times_ms.begin(),
+                                             algorithm.source_times_ms.end(), 0.0) / 1000.0;
+            if (seconds <= 0) continue;
+            std::cout << std::left << std::setw(24) << algorithm.name << std::right
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << run_sources.size() / seconds
+                      << std::setprecision(2)
+                      << std::setw(12) << total_edges / seconds / 1e6
+                      << std::setw(16) << total_vertices / seconds / 1e6 << "\n";
+        }
+        std::cout << "\n  MTEPS counts the out-edges of every reached vertex (the edges a search"
+                  << " scans)\n";
+    }
+
+    // Hardware counters
     std::cout << "\n";
     printSeparator('-');
-    std::cout << "Speedup Analysis (based on median times):\n";
+    std::cout << "Hardware Counters (mean per solve):\n";
     printSeparator('-');
 
-    double dijkstra_vs_new = dijkstra_stats.median / new_stats.median;
-    double lemon_vs_new = lemon_stats.median / new_stats.median;
-
-    std::cout << "  Dijkstra / New SSSP: " << std::fixed << std::setprecision(3)
-              << dijkstra_vs_new << "x";
-    if (dijkstra_vs_new > 1) {
-        std::cout << " (New SSSP is faster)";
+    if (counters.available()) {
+        std::vector<std::pair<std::string, PerfCounters::Sample>> rows;
+        for (const auto& algorithm : algorithms) {
+            rows.emplace_back(algorithm.name, meanSample(algorithm.counters));
+        }
+        double solves_per_run = static_cast<double>(run_sources.size());
+        printCounterTable("Per edge", std::max(1, graph.m) * solves_per_run, rows);
+        printCounterTable("Per vertex", std::max(1, graph.n) * solves_per_run, rows);
     } else {
-        std::cout << " (Dijkstra is faster)";
+        std::cout << "  Not available: " << counters.error() << "\n";
     }
+
+    // Memory, from one extra untimed run per algorithm returning a fresh Result
     std::cout << "\n";
+    printSeparator('-');
+    std::cout << "Memory (one untimed run each):\n";
+    printSeparator('-');
+
+    if (MemoryTracker::installed()) {
+        std::cout << "  Graph load:   " << std::fixed << std::setprecision(2)
+                  << toMB(load_memory[MemoryCategory::Graph].live_bytes) << " MB live, "
+                  << load_memory.total.allocations << " allocations\n\n";
+
+        algorithms[SimpleIndex].memory = measureMemory([&] {
+            auto result = SimpleDijkstra::solve(graph, source);
+        });
+        algorithms[LemonIndex].memory = measureMemory([&] {
+            auto result = DijkstraLemon::solve(graph, source);
+        });
+        algorithms[NewIndex].memory = measureMemory([&] {
+            NewSSSP solver(graph);
+            auto result = solver.solve(source);
+        });
 
-    std::cout << "  LEMON / New SSSP:    " << lemon_vs_new << "x";
-    if (lemon_vs_new > 1) {
-        std::cout << " (New SSSP is faster)";
+        std::vector<std::pair<std::string, MemoryUsage>> rows;
+        for (auto& algorithm : algorithms) {
+            algorithm.has_memory = true;
+            rows.emplace_back(algorithm.name, algorithm.memory);
+        }
+        printMemoryTable(rows);
+        if (!rows.back().second.peak_rss_reset) {
+            std::cout << "\n  * Peak RSS is the process high-water mark (could not reset it per run)\n";
+        }
     } else {
-        std::cout << " (LEMON is faster)";
+        std::cout << "  Not available: built without SSSP_ENABLE_MEMORY_TRACKING\n";
     }
+
+    // Speedup comparison
     std::cout << "\n";
+    printSeparator('-');
+    std::cout << "Speedup Analysis (based on median times):\n";
+    printSeparator('-');
+
+    // Ratios of medians with 95% bootstrap intervals over the individual runs
+    auto printSpeedup = [&](const char* label, size_t baseline_index, const char* baseline_name) {
+        RatioEstimate speedup = bootstrapMedianRatio(algorithms[baseline_index].times_ms,
+                                                     algorithms[NewIndex].times_ms);
+        std::cout << "  " << label << std::fixed << std::setprecision(3) << speedup.ratio
+                  << "x  [" << speedup.low << ", " << speedup.high << "] 95% CI";
+        if (speedup.low > 1) {
+            std::cout << " (New SSSP is faster)";
+        } else if (speedup.high < 1) {
+            std::cout << " (" << baseline_name << " is faster)";
+        } else {
+            std::cout << " (no significant difference)";
+        }
+        std::cout << "\n";
+    };
+    printSpeedup("Dijkstra / New SSSP: ", SimpleIndex, "Dijkstra");
+    printSpeedup("LEMON / New SSSP:    ", LemonIndex, "LEMON");
+
+    // Phases of the timed solves above, plus New SSSP's certificate checks.
+    // Each covers what its algorithm's timed figure covers: the solve for
+    // Dijkstra, setup and solve for New, conversion through extraction for LEMON.
+    std::cout << "\n";
+    printSeparator('-');
+    std::cout << "Phase Breakdown (median per timed solve, ms):\n";
+    printSeparator('-');
+
+    std::cout << std::left << std::setw(20) << "Algorithm" << std::right;
+    for (const char* phase : phase_names) std::cout << std::setw(11) << phase;
+    std::cout << std::setw(11) << "total" << "\n";
+    printSeparator('-', 86);
+    for (size_t a = 0; a < solves.size(); ++a) {
+        std::cout << std::left << std::setw(20) << algorithms[a].name << std::right
+                  << std::fixed << std::setprecision(3);
+        double total = 0;
+        for (const char* phase : phase_names) {
+            if (phase_timers[a].has(phase)) {
+                double ms = phase_timers[a].median(phase);
+                total += ms;
+                algorithms[a].phases_ms.emplace_back(phase, ms);
+                std::cout << std::setw(11) << ms;
+            } else {
+                std::cout << std::setw(11) << "-";
+            }
+        }
+        std::cout << std::setw(11) << total << "\n";
+    }
+    std::cout << "\n  Load: parse " << load_phases.median("parse") << " ms; preprocess: CSR build "
+              << preprocess.median("csr_build") << " ms (once, not solved on)\n";
+    for (const auto& phase : load_phases.names()) {
+        report.load_phases_ms.emplace_back(phase, load_phases.median(phase));
+    }
+    for (const auto& phase : preprocess.names()) {
+        report.preprocess_ms.emplace_back(phase, preprocess.median(phase));
+    }
+
+    // Per-level breakdown from one extra, instrumented run (not part of the timings above)
+    std::cout << "\n";
+    printSeparator('-');
+    std::cout << "BMSSP Per-Level Statistics (one instrumented run):\n";
+    printSeparator('-');
+
+    BasicNewSSSP<ProfilingPolicy> profiler(graph);
+    profiler.solve(source);
+    std::cout << "  k = " << profiler.getK() << ", t = " << profiler.getT()
+              << ", levels = " << profiler.getMaxLevel() << "\n\n";
+    printLevelStats(profiler.getLevelStats());
+
+    if (!stats_json_path.empty()) {
+        if (writeLevelStatsJson(stats_json_path, mtx_path, graph, source, profiler)) {
+            std::cout << "\n  Level statistics written to " << stats_json_path << "\n";
+        } else {
+            std::cerr << "Error writing " << stats_json_path << "\n";
+            return 1;
+        }
+    }
+
+    if (recorder) {
+        recorder->start();
+        recorder->instant("traced runs", "benchmark");
+        SimpleDijkstra::solve(graph, source, dist_buffer, pred_buffer);
+        DijkstraLemon::solve(graph, source);
+        NewSSSP solver(graph);
+        solver.solve(source, dist_buffer, pred_buffer);
+        recorder->stop();
+
+        if (recorder->writeChromeTrace(trace_path)) {
+            std::cout << "\n  Trace (" << recorder->size() << " events";
+            if (recorder->dropped() > 0) {
+                std::cout << ", " << recorder->dropped() << " oldest dropped";
+            }
+            std::cout << ") written to " << trace_path << "\n";
+        } else {
+            std::cerr << "Error writing " << trace_path << "\n";
+            return 1;
+        }
+    }
+
+    // Machine-readable output
+    if (!json_path.empty() || !csv_path.empty()) std::cout << "\n";
+    if (!json_path.empty()) {
+        if (!writeReportFile(json_path, report, writeJsonReport)) {
+            std::cerr << "Error writing " << json_path << "\n";
+            return 1;
+        }
+        std::cout << "  Results written to " << json_path << "\n";
+    }
+    if (!csv_path.empty()) {
+        if (!writeReportFile(csv_path, report, writeCsvReport)) {
+            std::cerr << "Error writing " << csv_path << "\n";
+            return 1;
+        }
+        std::cout << "  Per-run rows written to " << csv_path << "\n";
+    }
+
+    // Baseline comparison; the exit code tells scripts whether anything regressed
+    bool regressed = false;
+    if (!compare_path.empty()) {
+        std::cout << "\n";
+        printSeparator('-');
+        std::cout << "Baseline Comparison (median time vs " << compare_path << "):\n";
+        printSeparator('-');
+        regressed = printComparison(compareToBaseline(report, baseline, threshold), threshold);
+    }
 
     // Summary
     std::cout << "\n";
@@ -305,8 +1018,12 @@ int main(int argc, char* argv[]) {
     } else {
         std::cout << "Simple Dijkstra (" << dijkstra_stats.median << " ms)\n";
     }
+    if (!compare_path.empty()) {
+        std::cout << "  vs baseline:    " << (regressed ? "REGRESSION" : "no significant slowdown")
+                  << "\n";
+    }
 
     std::cout << "\n";
 
-    return 0;
+    return regressed ? 2 : 0;
 }
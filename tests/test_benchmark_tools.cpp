@@ -0,0 +1,366 @@
+#include <gtest/gtest.h>
+#include "new_sssp.hpp"
+#include "dijkstra_lemon.hpp"
+#include "graph_generator.hpp"
+#include "perf_counters.hpp"
+#include "benchmark_report.hpp"
+#include "benchmark_env.hpp"
+#include "source_sampler.hpp"
+#include "solver_phases.hpp"
+#include "operation_counts.hpp"
+#include "shortest_path_certificate.hpp"
+#include "graph500.hpp"
+#include "trace_recorder.hpp"
+#include "memory_tracker.hpp"
+#include <set>
+#include <sstream>
+
+using namespace sssp;
+
+TEST(PerfCountersTest, CountsOrReportsWhyNot) {
+    PerfCounters counters;
+    counters.start();
+    auto g = GraphGenerator::grid(20, 20, 1.0, 10.0, 64);
+    NewSSSP solver(g);
+    solver.solve(0);
+    counters.stop();
+    auto sample = counters.read();
+
+    if (!counters.available()) {
+        EXPECT_FALSE(counters.error().empty());
+        EXPECT_FALSE(sample.has(PerfCounters::Cycles));
+        return;
+    }
+    EXPECT_TRUE(sample.has(PerfCounters::Cycles));
+    EXPECT_GT(sample[PerfCounters::Cycles], 0.0);
+    if (sample.has(PerfCounters::Instructions)) {
+        EXPECT_GT(sample[PerfCounters::Instructions], 0.0);
+    }
+}
+
+TEST(BenchmarkReportTest, JsonRoundTripAndCompare) {
+    auto g = GraphGenerator::grid(6, 6, 1.0, 5.0, 66);
+
+    BenchmarkReport baseline;
+    baseline.graph_path = "grid \"6x6\".mtx";
+    baseline.n = g.n;
+    baseline.m = g.m;
+    baseline.fingerprint = graphFingerprint(g);
+    baseline.source = 3;
+    baseline.algorithms.resize(2);
+    baseline.algorithms[0].name = "steady";
+    baseline.algorithms[0].times_ms = {10.0, 10.2, 9.9, 10.1, 10.0, 9.8, 10.3, 10.0};
+    baseline.algorithms[1].name = "slowed";
+    baseline.algorithms[1].times_ms = baseline.algorithms[0].times_ms;
+
+    std::ostringstream json;
+    writeJsonReport(baseline, json);
+    auto doc = JsonValue::parse(json.str());
+    EXPECT_EQ(doc["graph"]["path"].asString(), baseline.graph_path);
+    EXPECT_EQ(doc["graph"]["fingerprint"].asString(), fingerprintHex(baseline.fingerprint));
+    EXPECT_EQ(doc["algorithms"][1]["times_ms"].asNumbers(), baseline.algorithms[1].times_ms);
+    EXPECT_DOUBLE_EQ(doc["algorithms"][0]["stats"]["median"].asNumber(), 10.0);
+    EXPECT_TRUE(doc["algorithms"][0]["memory"].isNull());
+    EXPECT_THROW(JsonValue::parse("{\"a\": [1, 2"), std::runtime_error);
+
+    std::ostringstream csv;
+    writeCsvReport(baseline, csv);
+    std::string rows_csv = csv.str();
+    EXPECT_EQ(std::count(rows_csv.begin(), rows_csv.end(), '\n'), 1 + 16);
+
+    // Same graph, one algorithm unchanged and one 50% slower
+    BenchmarkReport current = baseline;
+    for (double& t : current.algorithms[1].times_ms) t *= 1.5;
+    EXPECT_EQ(graphFingerprint(g), current.fingerprint);
+
+    auto rows = compareToBaseline(current, baseline, 0.05);
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_FALSE(rows[0].regression);
+    EXPECT_FALSE(rows[0].improvement);
+    EXPECT_LE(rows[0].ratio.low, 1.0);
+    EXPECT_GE(rows[0].ratio.high, 1.0);
+    EXPECT_TRUE(rows[1].regression);
+    EXPECT_NEAR(rows[1].ratio.ratio, 1.5, 1e-9);
+}
+
+TEST(BenchmarkStatsTest, OutliersAndSpeedupInterval) {
+    std::vector<double> times = {10, 11, 10, 12, 11, 10, 11, 40};
+    auto stats = BenchmarkStats::compute(times);
+    EXPECT_DOUBLE_EQ(stats.q1, 10.0);
+    EXPECT_DOUBLE_EQ(stats.q3, 11.25);
+    EXPECT_EQ(stats.outliers, 1u);
+    EXPECT_DOUBLE_EQ(stats.median, 11.0);
+    EXPECT_DOUBLE_EQ(times.back(), 40.0);  // Caller's order untouched
+
+    // Baseline four times slower: the interval brackets 4 and excludes 1
+    std::vector<double> slow;
+    for (double t : times) slow.push_back(4 * t);
+    auto speedup = bootstrapMedianRatio(slow, times);
+    EXPECT_DOUBLE_EQ(speedup.ratio, 4.0);
+    EXPECT_LE(speedup.low, 4.0);
+    EXPECT_GE(speedup.high, 4.0);
+    EXPECT_GT(speedup.low, 1.0);
+
+    CacheFlusher flusher(1 << 16);
+    EXPECT_GE(flusher.bytes(), size_t{1} << 16);
+    flusher.flush();
+}
+
+TEST(SourceSamplerTest, SamplesFromLargestStronglyConnectedComponent) {
+    // Cycle 0 -> 1 -> 2 -> 0 feeding a larger cycle 3 -> ... -> 7 -> 3, plus a sink 8
+    SimpleGraph g(9);
+    for (int v : {0, 1, 2}) g.add_edge(v, (v + 1) % 3, 1.0);
+    g.add_edge(2, 3, 1.0);
+    for (int v = 3; v <= 7; ++v) g.add_edge(v, v == 7 ? 3 : v + 1, 1.0);
+    g.add_edge(7, 8, 1.0);
+    g.add_edge(3, 4, 1.0);  // Parallel arc: vertex 3 has twice the out-degree
+
+    auto region = largestStronglyConnectedComponent(g);
+    EXPECT_EQ(region, (std::vector<int>{3, 4, 5, 6, 7}));
+
+    for (auto mode : {SourceSampling::Uniform, SourceSampling::Degree}) {
+        auto sources = sampleSources(g, region, 3, mode, 68);
+        ASSERT_EQ(sources.size(), 3u);
+        std::set<int> distinct(sources.begin(), sources.end());
+        EXPECT_EQ(distinct.size(), 3u);
+        for (int s : sources) EXPECT_TRUE(std::binary_search(region.begin(), region.end(), s));
+        EXPECT_EQ(sampleSources(g, region, 3, mode, 68), sources);  // Same seed, same sample
+    }
+    EXPECT_EQ(sampleSources(g, region, 50, SourceSampling::Uniform, 1).size(), region.size());
+
+    // Undirected graphs: the largest connected component
+    auto grid = GraphGenerator::grid(4, 4, 1.0, 2.0, 3);
+    EXPECT_EQ(static_cast<int>(largestStronglyConnectedComponent(grid).size()), grid.n);
+}
+
+TEST(SolverPhasesTest, PhasesCoverEachSolverAndAgree) {
+    auto g = GraphGenerator::grid(8, 8, 1.0, 9.0, 69);
+
+    PhaseTimer simple, lemon, fresh;
+    auto reference = solveSimpleDijkstraInPhases(g, 5, simple);
+    auto lemon_result = solveLemonInPhases(g, 5, lemon, true);
+    auto new_result = solveNewSSSPInPhases(g, 5, fresh, true);
+
+    EXPECT_EQ(simple.names(), (std::vector<std::string>{"setup", "solve", "extract"}));
+    EXPECT_EQ(lemon.names(),
+              (std::vector<std::string>{"convert", "setup", "solve", "extract", "verify"}));
+    EXPECT_EQ(fresh.names(), (std::vector<std::string>{"setup", "solve", "extract", "verify"}));
+    EXPECT_TRUE(lemon_result.certificate.valid());
+    EXPECT_TRUE(new_result.certificate.valid());
+    EXPECT_EQ(new_result.certificate.reached, static_cast<size_t>(g.n));
+    EXPECT_EQ(lemon_result.distances, reference.distances);
+    EXPECT_EQ(reference.predecessors[5], -1);
+
+    // Repeated phases keep one sample each
+    solveSimpleDijkstraInPhases(g, 5, simple);
+    EXPECT_EQ(simple.times("solve").size(), 2u);
+    EXPECT_GE(simple.total("solve"), simple.median("solve"));
+    EXPECT_EQ(simple.median("convert"), 0.0);
+
+    auto wrong = reference.distances;
+    wrong[7] += 1.0;
+    EXPECT_EQ(countMismatches(wrong, reference.distances), 1);
+}
+
+TEST(OperationCountTest, CountsAdditionsAndComparisonsOfEverySolver) {
+    CountedDouble a = 1.5;
+    auto basic = countOperations([&] {
+        CountedDouble b = a + 2.0;
+        EXPECT_TRUE(b > a);
+        EXPECT_FALSE(b < 1.0);
+    });
+    EXPECT_EQ(basic.additions, 1u);
+    EXPECT_EQ(basic.comparisons, 2u);
+
+    auto g = GraphGenerator::randomSparse(300, 1200, 1.0, 50.0, 70);
+    auto reference = SimpleDijkstra::solve(g, 0).distances;
+
+    // Dijkstra adds each out-edge of every settled vertex exactly once
+    std::vector<double> dijkstra, lemon, fresh;
+    auto dijkstra_counts = countSimpleDijkstraOperations(g, 0, &dijkstra);
+    uint64_t scanned = 0;
+    for (int u = 0; u < g.n; ++u) {
+        if (reference[u] < INF) scanned += g.outEdges(u).size();
+    }
+    EXPECT_EQ(dijkstra, reference);
+    EXPECT_EQ(dijkstra_counts.additions, scanned);
+    EXPECT_GT(dijkstra_counts.comparisons, scanned);  // Relaxations plus heap
+
+    auto lemon_counts = countLemonOperations(g, 0, &lemon);
+    EXPECT_EQ(lemon, reference);
+    EXPECT_GT(lemon_counts.total(), 0u);
+
+    // Counting observes the solver without changing its result
+    auto new_counts = countNewSSSPOperations(g, 0, &fresh);
+    EXPECT_EQ(fresh, NewSSSP(g).solve(0).distances);
+    EXPECT_GT(new_counts.additions, 0u);
+    EXPECT_GT(new_counts.comparisons, new_counts.additions);
+
+    EXPECT_GT(newSSSPBound(g.n, g.m), static_cast<double>(g.m));
+    EXPECT_GT(sortingBarrierBound(g.n, g.m), static_cast<double>(g.m));
+}
+
+TEST(CertificateTest, AcceptsShortestPathsAndFlagsEachViolation) {
+    auto g = GraphGenerator::randomSparse(3000, 12000, 1.0, 20.0, 71);
+    g.add_edge(0, 1, 0.5);
+    auto exact = SimpleDijkstra::solve(g, 0);
+
+    auto check = verifyShortestPaths(g, 0, exact.distances, exact.predecessors);
+    EXPECT_TRUE(check.valid());
+    EXPECT_TRUE(check.checked_predecessors);
+    EXPECT_EQ(check.first_bad_vertex, -1);
+    for (int threads : {1, 3}) {
+        auto split = verifyShortestPaths(g, 0, exact.distances, exact.predecessors, threads);
+        EXPECT_TRUE(split.valid());
+        EXPECT_EQ(split.reached, check.reached);
+    }
+    EXPECT_TRUE(verifyShortestPaths(g, 0, exact.distances, {}).valid());  // Distances only
+
+    // Too large: the edge 0 -> 1 improves it
+    auto dist = exact.distances;
+    dist[1] += 1.0;
+    auto large = verifyShortestPaths(g, 0, dist, exact.predecessors);
+    EXPECT_FALSE(large.valid());
+    EXPECT_GE(large.violated_edges, 1u);
+
+    // Too small: no edge into 1 is tight any more
+    dist = exact.distances;
+    dist[1] = 0.25;
+    auto small = verifyShortestPaths(g, 0, dist, exact.predecessors);
+    EXPECT_FALSE(small.valid());
+    EXPECT_GE(small.untight_vertices, 1u);
+    EXPECT_EQ(small.first_bad_vertex, 1);
+
+    // Predecessors: a wrong parent, and a vertex marked reached without a path
+    auto pred = exact.predecessors;
+    int v = 2;
+    while (pred[v] < 0) v++;
+    pred[v] = v;
+    auto cycle = verifyShortestPaths(g, 0, exact.distances, pred);
+    EXPECT_EQ(cycle.untight_vertices, 1u);
+    EXPECT_GE(cycle.unrooted_vertices, 1u);
+
+    pred = exact.predecessors;
+    dist = exact.distances;
+    int unreached = -1;
+    for (int u = 0; u < g.n && unreached < 0; ++u) {
+        if (dist[u] == INF) unreached = u;
+    }
+    if (unreached >= 0) {
+        pred[unreached] = 0;
+        EXPECT_EQ(verifyShortestPaths(g, 0, dist, pred).unrooted_vertices, 1u);
+    }
+
+    dist = exact.distances;
+    dist[0] = 1.0;
+    EXPECT_FALSE(verifyShortestPaths(g, 0, dist, exact.predecessors).source_ok);
+}
+
+TEST(Graph500Test, KernelValidatesEveryRootAndReportsTEPS) {
+    auto g = GraphGenerator::rmat(12, 8, 0.57, 0.19, 0.19, 0.05, 0.0, 1.0, 74, 1);
+    auto roots = sampleGraph500Roots(g, 16, 74);
+    ASSERT_EQ(roots.size(), 16u);
+    EXPECT_EQ(std::set<int>(roots.begin(), roots.end()).size(), roots.size());
+    for (int root : roots) EXPECT_FALSE(g.adj[root].empty());
+
+    auto kernel = runGraph500Kernel(g, roots, [&](int root, double* dist, int* pred) {
+        SimpleDijkstra::solve(g, root, dist, pred);
+    });
+    ASSERT_EQ(kernel.searches.size(), roots.size());
+    EXPECT_EQ(kernel.validated(), roots.size());
+    for (const auto& search : kernel.searches) {
+        EXPECT_GT(search.traversed_edges, 0);
+        EXPECT_LE(search.traversed_edges, g.m / 2);
+    }
+    auto stats = kernel.tepsStats();
+    EXPECT_GT(kernel.harmonicMeanTEPS(), 0);
+    EXPECT_LE(kernel.harmonicMeanTEPS(), stats.max);
+    EXPECT_GE(kernel.harmonicMeanTEPS(), stats.min);
+
+    // A solver that returns wrong distances is excluded from the rate
+    auto wrong = runGraph500Kernel(g, roots, [&](int root, double* dist, int* pred) {
+        SimpleDijkstra::solve(g, root, dist, pred);
+        if (root == roots[0]) dist[g.adj[root][0].first] += 1.0;
+    });
+    EXPECT_EQ(wrong.validated(), roots.size() - 1);
+}
+
+TEST(TraceRecorderTest, RingBufferKeepsNewestEvents) {
+    TraceRecorder recorder(4);
+    recorder.start();
+    for (int i = 0; i < 6; ++i) {
+        TraceScope scope("step", "test", "i", i);
+    }
+    recorder.stop();
+    { TraceScope ignored("after stop", "test"); }
+
+    auto events = recorder.events();
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(recorder.dropped(), 2u);
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_STREQ(events[i].name, "step");
+        EXPECT_EQ(events[i].arg_values[0], static_cast<double>(i + 2));
+        EXPECT_GE(events[i].duration_ns, 0);
+    }
+
+    std::ostringstream out;
+    recorder.writeChromeTrace(out);
+    EXPECT_NE(out.str().find("\"traceEvents\":["), std::string::npos);
+    EXPECT_NE(out.str().find("\"dropped_events\":2"), std::string::npos);
+}
+
+TEST(TraceRecorderTest, SolverRecordsRecursion) {
+#ifndef SSSP_ENABLE_TRACING
+    GTEST_SKIP() << "built without SSSP_ENABLE_TRACING";
+#endif
+    auto g = GraphGenerator::scaleFree(2000, 5, 3, 1.0, 100.0, 63);
+    TraceRecorder recorder;
+    recorder.start();
+    NewSSSP solver(g);
+    solver.solve(0);
+    SimpleDijkstra::solve(g, 0);
+    recorder.stop();
+
+    size_t bmssp = 0, pulls = 0, solves = 0, dijkstra = 0;
+    for (const auto& event : recorder.events()) {
+        std::string name = event.name;
+        bmssp += name == "BMSSP";
+        pulls += name == "pull";
+        solves += name == "NewSSSP::solve";
+        dijkstra += name == "SimpleDijkstra::solve";
+    }
+    EXPECT_EQ(solves, 1u);
+    EXPECT_EQ(dijkstra, 1u);
+    EXPECT_GT(pulls, 0u);
+    // One BMSSP call per pull plus the top-level call
+    EXPECT_EQ(bmssp, pulls + 1);
+}
+
+TEST(MemoryTrackerTest, ChargesSolverAllocationsByCategory) {
+    if (!MemoryTracker::installed()) {
+        GTEST_SKIP() << "counting allocator not linked";
+    }
+    auto g = GraphGenerator::scaleFree(2000, 5, 3, 1.0, 100.0, 65);
+
+    MemoryTracker::enable(true);
+    MemoryRun run;
+    NewSSSP::Result result;
+    {
+        NewSSSP solver(g);
+        result = solver.solve(0);
+    }
+    MemoryUsage usage = run.finish();
+    MemoryTracker::enable(false);
+
+    // Only the returned result outlives the run
+    size_t result_bytes = g.n * (sizeof(double) + sizeof(int));
+    EXPECT_EQ(usage[MemoryCategory::Results].live_bytes, static_cast<long long>(result_bytes));
+    EXPECT_EQ(usage[MemoryCategory::Workspace].live_bytes, 0);
+    EXPECT_EQ(usage[MemoryCategory::DataStructure].live_bytes, 0);
+    EXPECT_EQ(usage.total.live_bytes, static_cast<long long>(result_bytes));
+    EXPECT_GE(usage.total.peak_live_bytes, result_bytes);
+#ifdef SSSP_ENABLE_MEMORY_TRACKING
+    EXPECT_GT(usage[MemoryCategory::DataStructure].allocations, 0u);
+    EXPECT_GT(usage[MemoryCategory::Workspace].allocations, 0u);
+#endif
+}
@@ -2,22 +2,28 @@
 #include "new_sssp.hpp"
 #include "dijkstra_lemon.hpp"
 #include "graph_generator.hpp"
+#include "filtered_graph.hpp"
+#include "csr_graph.hpp"
+#include "pull_data_structures.hpp"
+#include "shortest_path_certificate.hpp"
 #include <cmath>
 
 using namespace sssp;
 
 /**
- * Correctness tests that compare the new algorithm with Dijkstra
+ * Correctness tests that compare the new algorithm with Dijkstra, and check
+ * its distances and predecessors as a shortest-path certificate
  */
 
 class CorrectnessTest : public ::testing::Test {
 protected:
     static constexpr double EPSILON = 1e-9;
 
+    template <typename DataStructure = BlockDataStructure>
     void compareResults(const SimpleGraph& g, int source) {
         auto dijkstra_result = SimpleDijkstra::solve(g, source);
 
-        NewSSSP solver(g);
+        BasicNewSSSP<DefaultPolicy, SimpleGraph, DataStructure> solver(g);
         auto new_result = solver.solve(source);
 
         for (int i = 0; i < g.n; ++i) {
@@ -28,6 +34,12 @@ protected:
                     << ", New: " << new_result.distances[i] << ")";
             }
         }
+
+        auto check = verifyShortestPaths(g, source, new_result.distances, new_result.predecessors);
+        EXPECT_TRUE(check.valid())
+            << "Certificate failed: " << check.violated_edges << " violated edges, "
+            << check.untight_vertices << " untight, " << check.unrooted_vertices
+            << " unrooted (first vertex " << check.first_bad_vertex << ")";
     }
 };
 
@@ -194,3 +206,83 @@ TEST_F(CorrectnessTest, LargerGraphStress) {
         compareResults(g, 0);
     }
 }
+
+// Solving on a FilteredGraph must match solving on the equivalent copied graph
+TEST_F(CorrectnessTest, FilteredGraphMatchesMaterializedCopy) {
+    auto g = GraphGenerator::grid(8, 8, 1.0, 10.0, 17);
+    FilteredGraph view(g);
+    for (int v : {9, 10, 27, 36}) {
+        view.closeVertex(v);
+    }
+    for (size_t id = 3; id < static_cast<size_t>(g.m); id += 11) {
+        view.closeEdge(id);
+    }
+    auto copy = view.materialize();
+
+    auto dijkstra_view = SimpleDijkstra::solve(view, 0);
+    auto dijkstra_copy = SimpleDijkstra::solve(copy, 0);
+    EXPECT_EQ(dijkstra_view.distances, dijkstra_copy.distances);
+    EXPECT_EQ(dijkstra_view.predecessors, dijkstra_copy.predecessors);
+
+    auto lemon_view = DijkstraLemon::solve(view, 0);
+    for (int i = 0; i < g.n; ++i) {
+        if (dijkstra_copy.distances[i] < INF) {
+            EXPECT_NEAR(lemon_view.distances[i], dijkstra_copy.distances[i], EPSILON);
+        } else {
+            EXPECT_EQ(lemon_view.distances[i], INF);
+        }
+    }
+
+    BasicNewSSSP<DefaultPolicy, FilteredGraph> new_view(view);
+    NewSSSP new_copy(copy);
+    EXPECT_EQ(new_view.solve(0).distances, new_copy.solve(0).distances);
+
+    compareResults(copy, 0);
+}
+
+// Weight-sorted CSR lets the bounded relax loops cut off early
+TEST_F(CorrectnessTest, WeightSortedCSRGraphs) {
+    for (int size = 3; size <= 10; size += 2) {
+        auto g = GraphGenerator::grid(size, size, 1.0, 10.0, size);
+        CSRGraph sorted(g, true);
+
+        auto dijkstra_result = SimpleDijkstra::solve(g, 0);
+        EXPECT_EQ(SimpleDijkstra::solve(sorted, 0).distances, dijkstra_result.distances);
+
+        BasicNewSSSP<DefaultPolicy, CSRGraph> solver(sorted);
+        auto new_result = solver.solve(0);
+        for (int i = 0; i < g.n; ++i) {
+            EXPECT_NEAR(dijkstra_result.distances[i], new_result.distances[i], EPSILON)
+                << "Distance mismatch at node " << i << " (grid " << size << ")";
+        }
+    }
+}
+
+// The cutoff only skips updates at or past the bound, which the caller redoes,
+// so sorting must not change what the solver finds
+TEST_F(CorrectnessTest, WeightSortedCSRMatchesUnsorted) {
+    for (int seed = 0; seed < 10; ++seed) {
+        auto random = GraphGenerator::randomSparse(300, 1200, 1.0, 100.0, seed);
+        auto scale_free = GraphGenerator::scaleFree(300, 5, 3, 1.0, 100.0, seed);
+        for (const auto* g : {&random, &scale_free}) {
+            CSRGraph unsorted(*g);
+            CSRGraph sorted(*g, true);
+            auto expected = BasicNewSSSP<DefaultPolicy, CSRGraph>(unsorted).solve(0);
+            auto actual = BasicNewSSSP<DefaultPolicy, CSRGraph>(sorted).solve(0);
+
+            EXPECT_EQ(actual.distances, expected.distances) << "seed " << seed;
+            EXPECT_EQ(actual.predecessors, expected.predecessors) << "seed " << seed;
+        }
+    }
+}
+
+TEST_F(CorrectnessTest, AlternativeDataStructures) {
+    for (int seed = 0; seed < 5; ++seed) {
+        auto random = GraphGenerator::randomSparse(300, 1200, 1.0, 100.0, seed);
+        auto scale_free = GraphGenerator::scaleFree(300, 5, 3, 1.0, 100.0, seed);
+        for (const auto* g : {&random, &scale_free}) {
+            compareResults<HeapDataStructure>(*g, 0);
+            compareResults<RadixDataStructure>(*g, 0);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "dijkstra_lemon.hpp"
 #include "graph_generator.hpp"
+#include "path_utils.hpp"
 
 using namespace sssp;
 
@@ -117,3 +118,151 @@ TEST(DijkstraTest, LargeRandomGraph) {
     // Most nodes should be reachable in a connected random graph
     EXPECT_GT(reachable, g.n / 2);
 }
+
+TEST(DijkstraTest, SolveIntoCallerBuffers) {
+    auto g = GraphGenerator::randomSparse(100, 400, 1.0, 100.0, 7);
+    auto expected = SimpleDijkstra::solve(g, 0);
+
+    std::vector<double> distances(3, 42.0);  // Wrong size and stale contents
+    std::vector<int> predecessors;
+    for (int source : {5, 0}) {
+        SimpleDijkstra::solve(g, source, distances, predecessors);
+    }
+
+    ASSERT_EQ(distances.size(), static_cast<size_t>(g.n));
+    EXPECT_EQ(distances, expected.distances);
+    EXPECT_EQ(predecessors, expected.predecessors);
+}
+
+TEST(PathUtilsTest, ExtractPath) {
+    // Diamond: shortest path to 3 is 0 -> 2 -> 3
+    SimpleGraph g(5);
+    g.add_edge(0, 1, 1.0);
+    g.add_edge(0, 2, 3.0);
+    g.add_edge(1, 3, 4.0);
+    g.add_edge(2, 3, 1.0);
+
+    auto result = SimpleDijkstra::solve(g, 0);
+
+    EXPECT_EQ(extractPath(result.predecessors, 0, 3), (std::vector<int>{0, 2, 3}));
+    EXPECT_EQ(extractPath(result.predecessors, 0, 0), (std::vector<int>{0}));
+    EXPECT_TRUE(extractPath(result.predecessors, 0, 4).empty());  // Unreachable
+    EXPECT_TRUE(extractPath(result.predecessors, 0, 7).empty());  // Out of range
+
+    EXPECT_EQ(pathHopCount(result.predecessors, 0, 3), 2);
+    EXPECT_EQ(pathHopCount(result.predecessors, 0, 0), 0);
+    EXPECT_EQ(pathHopCount(result.predecessors, 0, 4), -1);
+
+    auto paths = extractPaths(result.predecessors, 0, {1, 4, 3});
+    ASSERT_EQ(paths.size(), 3u);
+    EXPECT_EQ(paths[0], (std::vector<int>{0, 1}));
+    EXPECT_TRUE(paths[1].empty());
+    EXPECT_EQ(paths[2], (std::vector<int>{0, 2, 3}));
+}
+
+TEST(PathUtilsTest, CyclicPredecessorsAreRejected) {
+    std::vector<int> predecessors = {-1, 2, 1};
+    EXPECT_TRUE(extractPath(predecessors, 0, 1).empty());
+    EXPECT_EQ(pathHopCount(predecessors, 0, 2), -1);
+}
+
+TEST(PathUtilsTest, PathWeightsMatchDistances) {
+    auto g = GraphGenerator::randomSparse(200, 800, 1.0, 10.0, 11);
+    auto result = SimpleDijkstra::solve(g, 0);
+
+    for (int target : {17, 99, 150, 199}) {
+        auto path = extractPath(result.predecessors, 0, target);
+        ASSERT_FALSE(path.empty());
+        double length = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            double best = INF;
+            for (const auto& [v, w] : g.adj[path[i - 1]]) {
+                if (v == path[i]) best = std::min(best, w);
+            }
+            length += best;
+        }
+        EXPECT_NEAR(length, result.distances[target], 1e-9);
+    }
+}
+
+TEST(DijkstraTest, DistanceOnlyPolicy) {
+    auto g = GraphGenerator::randomSparse(100, 400, 1.0, 100.0, 9);
+    auto expected = SimpleDijkstra::solve(g, 0);
+    auto result = SimpleDijkstra::solve<DistanceOnlyPolicy>(g, 0);
+
+    EXPECT_EQ(result.distances, expected.distances);
+    EXPECT_TRUE(result.predecessors.empty());
+}
+
+namespace {
+
+// Stops as soon as the target is settled
+struct TargetVisitor : NullVisitor {
+    int target;
+    int settled = 0;
+    bool finished = false;
+    explicit TargetVisitor(int t) : target(t) {}
+
+    VisitAction settle(int u, double) {
+        settled++;
+        return u == target ? VisitAction::Stop : VisitAction::Continue;
+    }
+    void finish() { finished = true; }
+};
+
+// Never enters the forbidden vertex
+struct ForbiddenVertexVisitor : NullVisitor {
+    int forbidden;
+    explicit ForbiddenVertexVisitor(int f) : forbidden(f) {}
+
+    VisitAction relax(int, int v, double, double) {
+        return v == forbidden ? VisitAction::Prune : VisitAction::Continue;
+    }
+};
+
+}  // namespace
+
+TEST(DijkstraVisitorTest, StopAtTarget) {
+    SimpleGraph g(4);
+    g.add_edge(0, 1, 1.0);
+    g.add_edge(1, 2, 2.0);
+    g.add_edge(2, 3, 3.0);
+
+    TargetVisitor visitor(1);
+    auto result = SimpleDijkstra::solve(g, 0, visitor);
+
+    EXPECT_DOUBLE_EQ(result.distances[1], 1.0);
+    EXPECT_EQ(result.distances[3], INF);  // Never reached
+    EXPECT_EQ(visitor.settled, 2);
+    EXPECT_TRUE(visitor.finished);
+}
+
+TEST(DijkstraVisitorTest, PruneForbiddenVertex) {
+    // Diamond: forbidding 2 forces the path through 1
+    SimpleGraph g(4);
+    g.add_edge(0, 1, 1.0);
+    g.add_edge(0, 2, 3.0);
+    g.add_edge(1, 3, 4.0);
+    g.add_edge(2, 3, 1.0);
+
+    ForbiddenVertexVisitor visitor(2);
+    auto result = SimpleDijkstra::solve(g, 0, visitor);
+
+    EXPECT_EQ(result.distances[2], INF);
+    EXPECT_DOUBLE_EQ(result.distances[3], 5.0);
+    EXPECT_EQ(result.predecessors[3], 1);
+}
+
+TEST(DijkstraVisitorTest, NullVisitorHooksAreCompiledOut) {
+    static_assert(!VisitorTraits<NullVisitor>::can_stop);
+    static_assert(VisitorTraits<TargetVisitor>::settle);
+    static_assert(VisitorTraits<TargetVisitor>::finish);
+    static_assert(!VisitorTraits<TargetVisitor>::relax);
+    static_assert(VisitorTraits<ForbiddenVertexVisitor>::relax);
+
+    auto g = GraphGenerator::randomSparse(100, 400, 1.0, 100.0, 5);
+    NullVisitor visitor;
+    auto with_visitor = SimpleDijkstra::solve(g, 0, visitor);
+    auto plain = SimpleDijkstra::solve(g, 0);
+    EXPECT_EQ(with_visitor.distances, plain.distances);
+}
@@ -1,6 +1,18 @@
 #include <gtest/gtest.h>
 #include "graph_types.hpp"
 #include "graph_generator.hpp"
+#include "filtered_graph.hpp"
+#include "csr_graph.hpp"
+#include "road_network.hpp"
+#include "graph_cache.hpp"
+#include "new_sssp.hpp"
+#include "dijkstra_lemon.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <random>
+#include <set>
 
 using namespace sssp;
 
@@ -131,3 +143,272 @@ TEST(GraphGeneratorTest, Determinism) {
         }
     }
 }
+
+TEST(GraphGeneratorTest, ParallelGeneratorsIgnoreThreadCount) {
+    // Large enough for several edge chunks
+    int n = 100000;
+    auto sparse = GraphGenerator::randomSparse(n, 3 * n, 1.0, 100.0, 73, 1);
+    EXPECT_EQ(GraphGenerator::randomSparse(n, 3 * n, 1.0, 100.0, 73, 3).adj, sparse.adj);
+    EXPECT_EQ(sparse.m, 3 * n);
+
+    // Simple graph: no self-loops or duplicates left by the batched dedupe
+    size_t edges = 0;
+    for (int u = 0; u < n; ++u) {
+        std::set<int> targets;
+        for (const auto& [v, w] : sparse.adj[u]) {
+            EXPECT_NE(v, u);
+            EXPECT_TRUE(targets.insert(v).second);
+        }
+        edges += sparse.adj[u].size();
+    }
+    EXPECT_EQ(edges, static_cast<size_t>(sparse.m));
+
+    // Too dense to fill: stops at the complete graph
+    EXPECT_EQ(GraphGenerator::randomSparse(20, 1000, 1.0, 2.0, 1).m, 20 * 19);
+
+    auto scale_free = GraphGenerator::scaleFree(n, 5, 3, 1.0, 100.0, 73, 1);
+    EXPECT_EQ(GraphGenerator::scaleFree(n, 5, 3, 1.0, 100.0, 73, 3).adj, scale_free.adj);
+    EXPECT_EQ(scale_free.m, 2 * (5 * 4 / 2 + 3 * (n - 5)));  // Clique, then 3 per new node, both ways
+
+    // Preferential attachment: the largest hub far exceeds the average degree of 6
+    size_t max_degree = 0;
+    for (const auto& list : scale_free.adj) max_degree = std::max(max_degree, list.size());
+    EXPECT_GT(max_degree, 100u);
+}
+
+TEST(GraphGeneratorTest, RmatGraph) {
+    int scale = 12, edge_factor = 8;
+    auto g = GraphGenerator::rmat(scale, edge_factor, 0.57, 0.19, 0.19, 0.05, 0.0, 1.0, 74, 1);
+    EXPECT_EQ(GraphGenerator::rmat(scale, edge_factor, 0.57, 0.19, 0.19, 0.05, 0.0, 1.0, 74, 3).adj,
+              g.adj);
+    ASSERT_EQ(g.n, 1 << scale);
+    EXPECT_EQ(g.m % 2, 0);  // Every edge both ways, self-loops dropped
+    EXPECT_LE(g.m, 2 * edge_factor * g.n);
+    EXPECT_GT(g.m, edge_factor * g.n);
+
+    // Skewed degrees: the largest far above the average, many vertices isolated
+    size_t max_degree = 0;
+    int isolated = 0;
+    for (const auto& list : g.adj) {
+        max_degree = std::max(max_degree, list.size());
+        isolated += list.empty();
+    }
+    EXPECT_GT(max_degree, 20u * g.m / g.n);
+    EXPECT_GT(isolated, 0);
+}
+
+TEST(RoadNetworkTest, GeometricHierarchicalAndStreamed) {
+    RoadNetworkOptions options;
+    options.rows = 300;
+    options.cols = 200;
+    options.highway_spacing = 32;
+    RoadNetwork roads(options);
+    auto g = roads.toSimpleGraph(1);
+    EXPECT_EQ(roads.toSimpleGraph(3).adj, g.adj);
+    ASSERT_EQ(g.n, 300 * 200);
+
+    // Low degree, two-way roads with one time, no faster than their class allows
+    size_t max_degree = 0;
+    int highways = 0;
+    for (int u = 0; u < g.n; ++u) {
+        max_degree = std::max(max_degree, g.adj[u].size());
+        auto [ux, uy] = roads.coordinates(u);
+        EXPECT_LT(std::abs(ux - u % 200), 0.5);
+        EXPECT_LT(std::abs(uy - u / 200), 0.5);
+        roads.forEachRoad(u, [&](int v, double w, RoadClass cls) {
+            auto [vx, vy] = roads.coordinates(v);
+            double length = std::hypot(ux - vx, uy - vy);
+            double speed = options.speed[static_cast<int>(cls)];
+            EXPECT_GE(w, length / speed - 1e-12);
+            EXPECT_LT(w, length / speed * (1 + options.congestion));
+            if (cls == RoadClass::Highway) {
+                highways++;
+                EXPECT_NEAR(length, 32.0, 1.0);
+            }
+            bool back = false;
+            for (const auto& [x, wx] : g.adj[v]) back = back || (x == u && wx == w);
+            EXPECT_TRUE(back);
+        });
+    }
+    EXPECT_LE(max_degree, 12u);
+    EXPECT_GT(static_cast<double>(g.m) / g.n, 3.0);
+    EXPECT_LT(static_cast<double>(g.m) / g.n, 4.5);
+    EXPECT_EQ(highways, 2 * (10 * 6 + 9 * 7));  // 10 x 7 junctions, both ways
+
+    // Connected, through arterials, with a large hop diameter
+    std::vector<int> hops(g.n, -1);
+    std::queue<int> queue;
+    hops[0] = 0;
+    queue.push(0);
+    while (!queue.empty()) {
+        int u = queue.front();
+        queue.pop();
+        for (const auto& [v, w] : g.adj[u]) {
+            if (hops[v] < 0) {
+                hops[v] = hops[u] + 1;
+                queue.push(v);
+            }
+        }
+    }
+    EXPECT_EQ(std::count(hops.begin(), hops.end(), -1), 0);
+    EXPECT_GT(*std::max_element(hops.begin(), hops.end()), 25);
+
+    // The streamed file holds the same graph
+    namespace fs = std::filesystem;
+    fs::path file = fs::temp_directory_path() /
+                    ("sssp_road_test_" + std::to_string(std::random_device{}()) + ".csr");
+    roads.writeGraphFile(file.string(), "", 2);
+    {
+        MappedGraph mapped(file.string());
+        EXPECT_EQ(mapped.toSimpleGraph().adj, g.adj);
+        EXPECT_EQ(mapped.m, g.m);
+    }
+    fs::remove(file);
+}
+
+TEST(FilteredGraphTest, MasksHideVerticesAndEdges) {
+    SimpleGraph g(4);
+    g.add_edge(0, 1, 1.0);
+    g.add_edge(0, 2, 2.0);
+    g.add_edge(1, 3, 3.0);
+    g.add_edge(2, 3, 4.0);
+
+    FilteredGraph view(g);
+    EXPECT_EQ(view.n, 4);
+    EXPECT_EQ(view.edgeId(1, 0), 2u);
+
+    auto targets = [&](int u) {
+        std::vector<int> result;
+        for (const auto& [v, w] : view.outEdges(u)) result.push_back(v);
+        return result;
+    };
+
+    EXPECT_EQ(targets(0), (std::vector<int>{1, 2}));
+
+    view.closeEdge(0, 0);
+    EXPECT_EQ(targets(0), (std::vector<int>{2}));
+    EXPECT_FALSE(view.isEdgeOpen(0, 0));
+    EXPECT_EQ(view.closedEdgeCount(), 1);
+
+    view.closeVertex(2);
+    EXPECT_TRUE(targets(0).empty());  // 0 -> 2 hidden by the vertex mask
+    EXPECT_TRUE(targets(2).empty());  // Closed vertex has no out-edges
+    EXPECT_EQ(targets(1), (std::vector<int>{3}));
+
+    view.closeVertex(2);  // Idempotent
+    EXPECT_EQ(view.closedVertexCount(), 1);
+
+    view.openEdge(0, 0);
+    view.openVertex(2);
+    EXPECT_EQ(targets(0), (std::vector<int>{1, 2}));
+    EXPECT_EQ(view.closedEdgeCount(), 0);
+    EXPECT_EQ(view.closedVertexCount(), 0);
+
+    // Base graph is never modified
+    EXPECT_EQ(g.m, 4);
+    EXPECT_EQ(g.adj[0].size(), 2u);
+}
+
+TEST(FilteredGraphTest, MaterializeMatchesIteration) {
+    auto g = GraphGenerator::randomSparse(50, 200, 1.0, 100.0, 3);
+    FilteredGraph view(g);
+    for (size_t id = 0; id < static_cast<size_t>(g.m); id += 7) {
+        view.closeEdge(id);
+    }
+    view.closeVertex(5);
+
+    auto sub = view.materialize();
+    EXPECT_EQ(sub.n, g.n);
+    EXPECT_LT(sub.m, g.m);
+    EXPECT_TRUE(sub.adj[5].empty());
+    for (int u = 0; u < sub.n; ++u) {
+        for (const auto& [v, w] : sub.adj[u]) {
+            EXPECT_NE(v, 5);
+        }
+    }
+
+    view.reset();
+    EXPECT_EQ(view.materialize().m, g.m);
+}
+
+TEST(CSRGraphTest, MatchesAdjacencyLists) {
+    auto g = GraphGenerator::randomSparse(60, 250, 1.0, 100.0, 4);
+    CSRGraph csr(g);
+
+    EXPECT_EQ(csr.n, g.n);
+    EXPECT_EQ(csr.m, g.m);
+    EXPECT_FALSE(csr.weight_sorted);
+    for (int u = 0; u < g.n; ++u) {
+        ASSERT_EQ(csr.outDegree(u), static_cast<int>(g.adj[u].size()));
+        auto edges = csr.outEdges(u);
+        EXPECT_TRUE(std::equal(edges.begin(), edges.end(), g.adj[u].begin()));
+    }
+}
+
+TEST(CSRGraphTest, WeightSortedAdjacency) {
+    auto g = GraphGenerator::randomSparse(60, 250, 1.0, 100.0, 5);
+    CSRGraph csr(g, true);
+
+    EXPECT_TRUE(csr.weight_sorted);
+    EXPECT_EQ(csr.m, g.m);
+    for (int u = 0; u < g.n; ++u) {
+        auto edges = csr.outEdges(u);
+        ASSERT_EQ(edges.size(), g.adj[u].size());
+        EXPECT_TRUE(std::is_sorted(edges.begin(), edges.end(),
+                                   [](const auto& a, const auto& b) { return a.second < b.second; }));
+        // Same multiset of edges
+        std::vector<std::pair<int, double>> expected(g.adj[u].begin(), g.adj[u].end());
+        std::vector<std::pair<int, double>> actual(edges.begin(), edges.end());
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(GraphCacheTest, MapsWrittenGraphsAndRegeneratesBadFiles) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / ("sssp_graph_cache_test_" + std::to_string(std::random_device{}()));
+    fs::remove_all(dir);
+
+    auto g = GraphGenerator::randomSparse(2000, 8000, 1.0, 50.0, 72);
+    int calls = 0;
+    auto generate = [&] { calls++; return g; };
+    {
+        GraphCache cache(dir.string());
+        const MappedGraph& mapped = cache.get("sparse", generate);
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(&cache.get("sparse", generate), &mapped);  // Same mapping, not regenerated
+        ASSERT_EQ(mapped.n, g.n);
+        ASSERT_EQ(mapped.m, g.m);
+        for (int u = 0; u < g.n; ++u) {
+            auto span = mapped.outEdges(u);
+            ASSERT_EQ(std::vector<MappedGraph::Edge>(span.begin(), span.end()), g.adj[u]);
+        }
+        EXPECT_EQ(SimpleDijkstra::solve(mapped, 0).distances, SimpleDijkstra::solve(g, 0).distances);
+        BasicNewSSSP<DefaultPolicy, MappedGraph> on_mapped(mapped);
+        NewSSSP on_simple(g);
+        EXPECT_EQ(on_mapped.solve(0).distances, on_simple.solve(0).distances);
+    }
+
+    // A later cache (another process, in practice) maps the file
+    GraphCache reopened(dir.string());
+    EXPECT_EQ(reopened.get("sparse", generate).toSimpleGraph().adj, g.adj);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(reopened.diskHits(), 1u);
+
+    // Files for another key, truncated or foreign are rejected, and regenerated by the cache
+    std::string file = reopened.path("sparse");
+    EXPECT_THROW(MappedGraph(file, "other"), std::runtime_error);
+    fs::resize_file(file, fs::file_size(file) - 1);
+    EXPECT_THROW(MappedGraph(file, "sparse"), std::runtime_error);
+    std::ofstream(reopened.path("foreign")) << "not a graph";
+    EXPECT_THROW(MappedGraph(reopened.path("foreign")), std::runtime_error);
+    EXPECT_THROW(MappedGraph((dir / "missing.csr").string()), std::runtime_error);
+
+    GraphCache repaired(dir.string());
+    EXPECT_EQ(repaired.get("sparse", generate).m, g.m);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(repaired.generated(), 1u);
+
+    fs::remove_all(dir);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "counting_allocator.hpp"  // MemoryTracker counts for this binary
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,7 +1,15 @@
 #include <gtest/gtest.h>
 #include "new_sssp.hpp"
+#include "dijkstra_lemon.hpp"
 #include "graph_generator.hpp"
 #include "block_data_structure.hpp"
+#include "frontier.hpp"
+#include "pull_data_structures.hpp"
+#include "sharded_block_data_structure.hpp"
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <random>
 
 using namespace sssp;
 
@@ -64,6 +72,232 @@ TEST(BlockDataStructureTest, DuplicateKeys) {
     EXPECT_DOUBLE_EQ(ds.getValue(0), 5.0);
 }
 
+// The separator must not exceed an element left in a block pull did not scan
+template <typename DS>
+void expectSeparatorBelowUnscannedBlocks() {
+    DS ds;
+    ds.initialize(2, 1000.0, 10);
+    ds.insert(10, 20.0);
+    ds.insert(11, 21.0);
+    std::vector<typename DS::KeyValue> items = {{0, 5.0}, {1, 6.0}, {2, 7.0}};
+    ds.batchPrepend(items);
+
+    auto [keys, bound] = ds.pull();
+    EXPECT_EQ(std::set<int>(keys.begin(), keys.end()), (std::set<int>{0, 1}));
+    EXPECT_DOUBLE_EQ(bound, 7.0);
+
+    auto next = ds.pull().first;
+    EXPECT_EQ(std::count(next.begin(), next.end(), 2), 1);
+}
+
+TEST(BlockDataStructureTest, SeparatorBelowUnscannedBlocks) {
+    expectSeparatorBelowUnscannedBlocks<BlockDataStructure>();
+}
+
+TEST(LazyBlockDataStructureTest, SeparatorBelowUnscannedBlocks) {
+    expectSeparatorBelowUnscannedBlocks<LazyBlockDataStructure>();
+}
+
+TEST(LazyBlockDataStructureTest, StaleEntriesAreSkipped) {
+    LazyBlockDataStructure ds;
+    ds.initialize(2, 1000.0, 10);
+
+    ds.insert(0, 10.0);
+    ds.insert(1, 20.0);
+    ds.insert(0, 5.0);   // Supersedes the entry (0, 10)
+    ds.insert(0, 7.0);   // Ignored
+    ds.insert(2, 30.0);
+
+    EXPECT_EQ(ds.size(), 3u);
+    EXPECT_DOUBLE_EQ(ds.getValue(0), 5.0);
+    EXPECT_EQ(ds.stats().entries, 4u);
+    EXPECT_EQ(ds.stats().stale_entries, 1u);
+
+    auto [keys, bound] = ds.pull();
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(keys, std::vector<int>({0, 1}));  // Key 0 pulled once
+    EXPECT_DOUBLE_EQ(bound, 30.0);
+
+    std::tie(keys, bound) = ds.pull();
+    EXPECT_EQ(keys, std::vector<int>({2}));
+    EXPECT_DOUBLE_EQ(bound, 1000.0);
+    EXPECT_TRUE(ds.empty());
+}
+
+TEST(LazyBlockDataStructureTest, MatchesBlockDataStructureInNewSSSP) {
+    for (int seed = 0; seed < 5; ++seed) {
+        auto g = GraphGenerator::randomSparse(500, 2000, 1.0, 100.0, seed);
+
+        NewSSSP eager(g);
+        BasicNewSSSP<DefaultPolicy, SimpleGraph, LazyBlockDataStructure> lazy(g);
+        auto expected = eager.solve(0);
+        auto result = lazy.solve(0);
+
+        EXPECT_EQ(result.distances, expected.distances);
+        EXPECT_GT(lazy.getDataStructureStats().entries, 0u);
+    }
+}
+
+template <int M>
+void checkFixedMatchesRuntime() {
+    std::mt19937 rng(M);
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+
+    LazyBlockDataStructure runtime_ds;
+    FixedBlockDataStructure<M> fixed_ds;
+    runtime_ds.initialize(M, 1000.0, 200);
+    fixed_ds.initialize(M, 1000.0, 200);
+    for (int i = 0; i < 200; ++i) {
+        int key = i % 150;  // Some keys are lowered or ignored
+        double value = dist(rng);
+        runtime_ds.insert(key, value);
+        fixed_ds.insert(key, value);
+    }
+
+    while (!runtime_ds.empty()) {
+        auto [expected_keys, expected_bound] = runtime_ds.pull();
+        auto [keys, bound] = fixed_ds.pull();
+        std::sort(expected_keys.begin(), expected_keys.end());
+        std::sort(keys.begin(), keys.end());
+        EXPECT_EQ(keys, expected_keys);
+        EXPECT_DOUBLE_EQ(bound, expected_bound);
+    }
+    EXPECT_TRUE(fixed_ds.empty());
+}
+
+TEST(FixedBlockDataStructureTest, MatchesRuntimeBlockSize) {
+    checkFixedMatchesRuntime<1>();
+    checkFixedMatchesRuntime<4>();
+    checkFixedMatchesRuntime<16>();
+    checkFixedMatchesRuntime<7>();  // Odd size: network over 8 slots
+}
+
+TEST(ShardedBlockDataStructureTest, ConcurrentInsertsMergeDeterministically) {
+    const int num_keys = 2000;
+
+    // Each thread writes every key with its own value; the minimum must win
+    // no matter how keys are split over shards.
+    auto fill = [&](int num_threads) {
+        ShardedBlockDataStructure<> ds(num_threads);
+        ds.initialize(64, 1e9, num_keys);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&ds, t, num_threads, num_keys] {
+                for (int key = t; key < num_keys * num_threads; key += num_threads) {
+                    int k = key % num_keys;
+                    ds.insert(t, k, static_cast<double>(k) + key / num_keys);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        std::vector<std::vector<int>> pulls;
+        while (!ds.empty()) {
+            pulls.push_back(ds.pull().first);
+        }
+        return pulls;
+    };
+
+    auto single = fill(1);
+    auto sharded = fill(4);
+    EXPECT_EQ(sharded, single);
+
+    size_t total = 0;
+    for (const auto& keys : sharded) total += keys.size();
+    EXPECT_EQ(total, static_cast<size_t>(num_keys));
+}
+
+TEST(ShardedBlockDataStructureTest, UsableAsBMSSPStructure) {
+    auto g = GraphGenerator::grid(10, 10, 1.0, 10.0, 59);
+    auto expected = SimpleDijkstra::solve(g, 0);
+
+    BasicNewSSSP<DefaultPolicy, SimpleGraph, ShardedBlockDataStructure<>> solver(g);
+    auto result = solver.solve(0);
+    for (int i = 0; i < g.n; ++i) {
+        EXPECT_NEAR(result.distances[i], expected.distances[i], 1e-9);
+    }
+}
+
+// Tests for the alternative D implementations
+template <typename DataStructure>
+void checkPullOrder() {
+    DataStructure ds;
+    ds.initialize(3, 1000.0, 10);
+
+    ds.insert(0, 5.0);
+    ds.insert(1, 3.0);
+    ds.insert(2, 7.0);
+    ds.insert(3, 9.0);
+    ds.insert(2, 1.0);   // Lowers key 2
+    ds.insert(1, 8.0);   // Ignored, 3.0 is smaller
+    EXPECT_EQ(ds.size(), 4u);
+
+    auto [keys, bound] = ds.pull();
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(keys, std::vector<int>({0, 1, 2}));  // Exactly the 3 smallest
+    EXPECT_DOUBLE_EQ(bound, 9.0);
+
+    // Values below everything left, as BMSSP prepends them
+    std::vector<typename DataStructure::KeyValue> items = {{4, 2.0}, {5, 4.0}, {4, 6.0}};
+    ds.batchPrepend(items);
+    EXPECT_EQ(ds.size(), 3u);
+
+    std::tie(keys, bound) = ds.pull();
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(keys, std::vector<int>({3, 4, 5}));
+    EXPECT_DOUBLE_EQ(bound, 1000.0);  // Empty: bound is B
+    EXPECT_TRUE(ds.empty());
+}
+
+TEST(PullDataStructureTest, HeapPullsExactSmallest) {
+    checkPullOrder<HeapDataStructure>();
+}
+
+TEST(PullDataStructureTest, RadixPullsExactSmallest) {
+    checkPullOrder<RadixDataStructure>();
+}
+
+// Tests for Frontier
+TEST(FrontierTest, SparseAndDenseIterateInAscendingOrder) {
+    const int n = 100000;
+    Frontier sparse(n), dense(n);
+
+    std::vector<int> few = {900, 3, 64, 63, 500};
+    for (int v : few) sparse.insert(v);
+    EXPECT_FALSE(sparse.insert(64));  // Already a member
+    EXPECT_FALSE(sparse.isDense());
+
+    for (int v = n - 1; v >= 0; v -= 7) dense.insert(v);  // Inserted in descending order
+    EXPECT_TRUE(dense.isDense());
+
+    std::vector<int> seen;
+    sparse.forEach([&](int v) { seen.push_back(v); return true; });
+    EXPECT_EQ(seen, std::vector<int>({3, 63, 64, 500, 900}));
+
+    seen.clear();
+    dense.forEach([&](int v) { seen.push_back(v); return true; });
+    ASSERT_EQ(seen.size(), dense.size());
+    EXPECT_TRUE(std::is_sorted(seen.begin(), seen.end()));
+    for (int v : seen) EXPECT_EQ((n - 1 - v) % 7, 0);
+}
+
+TEST(FrontierTest, ClearAndEarlyStop) {
+    Frontier f(200);
+    for (int v = 0; v < 200; v += 2) f.insert(v);
+
+    int visited = 0;
+    EXPECT_FALSE(f.forEach([&](int v) { visited++; return v < 10; }));
+    EXPECT_EQ(visited, 6);  // 0, 2, ..., 10
+
+    f.clear();
+    EXPECT_TRUE(f.empty());
+    for (int v = 0; v < 200; ++v) EXPECT_FALSE(f.contains(v));
+
+    f.insert(150);
+    EXPECT_TRUE(f.contains(150));
+    EXPECT_EQ(f.size(), 1u);
+}
+
 // Tests for NewSSSP algorithm
 TEST(NewSSSPTest, SimplePathGraph) {
     SimpleGraph g(4);
@@ -161,3 +395,230 @@ TEST(NewSSSPTest, GridGraph) {
         EXPECT_LT(result.distances[i], INF);
     }
 }
+
+TEST(NewSSSPTest, SolveIntoCallerBuffers) {
+    SimpleGraph g(4);
+    g.add_edge(0, 1, 1.0);
+    g.add_edge(0, 2, 3.0);
+    g.add_edge(1, 3, 4.0);
+    g.add_edge(2, 3, 1.0);
+
+    NewSSSP solver(g);
+    auto expected = solver.solve(0);
+
+    // Vectors are resized and reused across queries
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+    solver.solve(0, distances, predecessors);
+    ASSERT_EQ(distances.size(), 4u);
+    EXPECT_EQ(distances, expected.distances);
+    EXPECT_EQ(predecessors, expected.predecessors);
+
+    // Raw spans, e.g. one row of a distance matrix
+    std::vector<double> matrix(2 * g.n, -1.0);
+    std::vector<int> pred_matrix(2 * g.n, -2);
+    solver.solve(1, matrix.data() + g.n, pred_matrix.data() + g.n);
+    EXPECT_DOUBLE_EQ(matrix[0], -1.0);  // First row untouched
+    EXPECT_DOUBLE_EQ(matrix[g.n + 1], 0.0);
+    EXPECT_DOUBLE_EQ(matrix[g.n + 3], 4.0);
+    EXPECT_EQ(matrix[g.n + 0], INF);
+    EXPECT_EQ(pred_matrix[g.n + 3], 1);
+}
+
+TEST(NewSSSPTest, DistanceOnlyPolicyMatchesDefault) {
+    auto g = GraphGenerator::grid(6, 6, 1.0, 5.0, 3);
+
+    NewSSSP full(g);
+    auto expected = full.solve(0);
+
+    BasicNewSSSP<DistanceOnlyPolicy> solver(g);
+    auto result = solver.solve(0);
+
+    EXPECT_EQ(result.distances, expected.distances);
+    EXPECT_TRUE(result.predecessors.empty());
+    EXPECT_EQ(solver.getRelaxationCount(), 0u);
+    EXPECT_GT(full.getRelaxationCount(), 0u);
+
+    std::vector<double> distances;
+    solver.solve(0, distances);
+    EXPECT_EQ(distances, expected.distances);
+}
+
+TEST(NewSSSPTest, TracingPolicyRecordsCalls) {
+    auto g = GraphGenerator::grid(4, 4, 1.0, 2.0, 42);
+
+    BasicNewSSSP<TracingPolicy> traced(g);
+    auto result = traced.solve(0);
+    NewSSSP untraced(g);
+    untraced.solve(0);
+
+    ASSERT_FALSE(traced.getCallTrace().empty());
+    EXPECT_DOUBLE_EQ(traced.getCallTrace().front().bound, INF);
+    EXPECT_EQ(traced.getCallTrace().front().num_sources, 1u);
+    EXPECT_TRUE(untraced.getCallTrace().empty());
+    EXPECT_EQ(traced.getRelaxationCount(), untraced.getRelaxationCount());
+}
+
+TEST(NewSSSPTest, LevelStatsCoverAllLevels) {
+    auto g = GraphGenerator::scaleFree(2000, 5, 3, 1.0, 100.0, 62);
+
+    BasicNewSSSP<ProfilingPolicy> profiled(g);
+    auto result = profiled.solve(0);
+    NewSSSP plain(g);
+    auto expected = plain.solve(0);
+
+    const auto& levels = profiled.getLevelStats();
+    ASSERT_EQ(static_cast<int>(levels.size()), profiled.getMaxLevel() + 1);
+    EXPECT_EQ(levels.back().calls, 1u);
+    EXPECT_TRUE(plain.getLevelStats().empty());
+    EXPECT_EQ(result.distances, expected.distances);
+
+    size_t relaxations = 0;
+    for (size_t l = 0; l < levels.size(); ++l) {
+        EXPECT_EQ(levels[l].level, static_cast<int>(l));
+        relaxations += levels[l].relaxations;
+        if (l > 0) {
+            // Inclusive time and pulls: every lower-level call is issued by a pull
+            EXPECT_GE(levels[l].time_ms, levels[l - 1].time_ms);
+            EXPECT_EQ(levels[l].pulls, levels[l - 1].calls);
+        }
+    }
+    EXPECT_EQ(relaxations, profiled.getRelaxationCount());
+}
+
+namespace {
+
+struct ForbidVertex : NullVisitor {
+    int forbidden;
+    explicit ForbidVertex(int f) : forbidden(f) {}
+
+    VisitAction relax(int, int v, double, double) {
+        return v == forbidden ? VisitAction::Prune : VisitAction::Continue;
+    }
+};
+
+struct StopOnSettle : NullVisitor {
+    int target;
+    bool seen = false;
+    bool finished = false;
+    explicit StopOnSettle(int t) : target(t) {}
+
+    VisitAction settle(int u, double) {
+        if (u == target) {
+            seen = true;
+            return VisitAction::Stop;
+        }
+        return VisitAction::Continue;
+    }
+    void finish() { finished = true; }
+};
+
+// Records the distance each vertex is settled with
+struct RecordSettles : NullVisitor {
+    std::vector<double> at_settle;
+    explicit RecordSettles(int n) : at_settle(n, INF) {}
+
+    VisitAction settle(int u, double dist) {
+        at_settle[u] = dist;
+        return VisitAction::Continue;
+    }
+};
+
+// Declares every hook, so none of them is compiled out
+struct CountingVisitor {
+    int discovered = 0, relaxed = 0, settled = 0, finished = 0;
+    VisitAction discover(int, double) { discovered++; return VisitAction::Continue; }
+    VisitAction relax(int, int, double, double) { relaxed++; return VisitAction::Continue; }
+    VisitAction settle(int, double) { settled++; return VisitAction::Continue; }
+    void finish() { finished++; }
+};
+
+}  // namespace
+
+TEST(NewSSSPVisitorTest, PruneForbiddenVertex) {
+    // Path 0 -> 1 -> 2 -> 3 plus an expensive bypass 0 -> 3
+    SimpleGraph g(4);
+    g.add_edge(0, 1, 1.0);
+    g.add_edge(1, 2, 1.0);
+    g.add_edge(2, 3, 1.0);
+    g.add_edge(0, 3, 10.0);
+
+    ForbidVertex visitor(2);
+    NewSSSP solver(g);
+    auto result = solver.solve(0, visitor);
+
+    EXPECT_DOUBLE_EQ(result.distances[1], 1.0);
+    EXPECT_EQ(result.distances[2], INF);
+    EXPECT_DOUBLE_EQ(result.distances[3], 10.0);
+}
+
+TEST(NewSSSPVisitorTest, StopOnSettle) {
+    SimpleGraph g(4);
+    g.add_edge(0, 1, 1.0);
+    g.add_edge(1, 2, 2.0);
+    g.add_edge(2, 3, 3.0);
+
+    StopOnSettle visitor(0);
+    NewSSSP solver(g);
+    auto result = solver.solve(0, visitor);
+
+    EXPECT_TRUE(visitor.seen);
+    EXPECT_TRUE(visitor.finished);
+    EXPECT_DOUBLE_EQ(result.distances[0], 0.0);
+    EXPECT_EQ(result.distances[1], INF);  // Stopped before relaxing the source
+}
+
+TEST(NewSSSPVisitorTest, StopAtTargetKeepsItsDistance) {
+    // Settle fires only once a distance is final, so stopping there keeps it
+    for (unsigned seed : {19u, 29u}) {
+        auto g = GraphGenerator::grid(15, 15, 1.0, 10.0, seed);
+        auto reference = SimpleDijkstra::solve(g, 0);
+        NewSSSP solver(g);
+
+        for (int target = 0; target < g.n; ++target) {
+            StopOnSettle visitor(target);
+            auto result = solver.solve(0, visitor);
+            EXPECT_TRUE(visitor.seen) << "seed " << seed << ", target " << target;
+            EXPECT_NEAR(result.distances[target], reference.distances[target], 1e-9)
+                << "seed " << seed << ", target " << target;
+        }
+    }
+}
+
+TEST(NewSSSPVisitorTest, SettledDistancesAreFinal) {
+    std::vector<SimpleGraph> graphs;
+    for (unsigned seed = 0; seed < 40; ++seed) {
+        graphs.push_back(GraphGenerator::grid(15, 15, 1.0, 10.0, seed));
+        graphs.push_back(GraphGenerator::randomSparse(100, 500, 1.0, 100.0, seed));
+        graphs.push_back(GraphGenerator::scaleFree(200, 3, 2, 1.0, 100.0, seed));
+    }
+
+    for (size_t i = 0; i < graphs.size(); ++i) {
+        const auto& g = graphs[i];
+        auto reference = SimpleDijkstra::solve(g, 0);
+        RecordSettles visitor(g.n);
+        NewSSSP(g).solve(0, visitor);
+
+        for (int v = 0; v < g.n; ++v) {
+            if (reference.distances[v] == INF) continue;
+            ASSERT_NEAR(visitor.at_settle[v], reference.distances[v], 1e-9)
+                << "graph " << i << ", vertex " << v;
+        }
+    }
+}
+
+TEST(NewSSSPVisitorTest, ContinueVisitorMatchesPlainSolve) {
+    auto g = GraphGenerator::grid(5, 5, 1.0, 3.0, 8);
+
+    NewSSSP solver(g);
+    auto plain = solver.solve(0);
+
+    CountingVisitor visitor;
+    auto visited = solver.solve(0, visitor);
+
+    EXPECT_EQ(visited.distances, plain.distances);
+    EXPECT_EQ(visitor.discovered, g.n);
+    EXPECT_GT(visitor.relaxed, 0);
+    EXPECT_GT(visitor.settled, 0);
+    EXPECT_EQ(visitor.finished, 1);
+}